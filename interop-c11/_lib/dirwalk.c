@@ -0,0 +1,624 @@
+// dirwalk.c
+#define _GNU_SOURCE
+#include "dirwalk.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define BATCH_ENTRIES 256
+#define BATCH_PATH_BYTES (64 * 1024)
+#define DENTS_BYTES (64 * 1024)
+#define QUEUE_BATCHES 16 // pull mode: batches produced ahead of the reader
+#define MAX_THREADS 64
+
+// Layout of the records getdents64 fills in.
+struct linux_dirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[];
+};
+
+// ===== Batches =====
+
+typedef struct Batch {
+  WalkBatch view;
+  WalkEntry entries[BATCH_ENTRIES];
+  char paths[BATCH_PATH_BYTES];
+  size_t path_used;
+  struct Batch *next; // queue / free list link
+} Batch;
+
+static Batch *batch_new(void) {
+  Batch *b = malloc(sizeof *b);
+  if (b) {
+    b->view = (WalkBatch){.count = 0, .entries = b->entries};
+    b->path_used = 0;
+    b->next = NULL;
+  }
+  return b;
+}
+
+static void batch_reset(Batch *b) {
+  b->view.count = 0;
+  b->path_used = 0;
+}
+
+// ===== Work-stealing deques =====
+// The owner pushes and pops directories at the tail (depth first, warm
+// dentry cache); idle workers steal the oldest, usually largest, subtrees
+// from the head. A per-deque mutex is uncontended outside of steals.
+
+// An open directory, shared by the tasks for its subdirectories so each
+// one opens with openat relative to it: no lookup from the root per
+// directory, no PATH_MAX limit, and a rename higher up mid-walk cannot
+// redirect the walk. Closed when the last task using it is done.
+typedef struct {
+  int fd;
+  atomic_uint refs; // the reader, plus one per task not yet opened
+} DirHandle;
+
+static void dir_handle_release(DirHandle *h) {
+  if (h && atomic_fetch_sub(&h->refs, 1) == 1) {
+    close(h->fd);
+    free(h);
+  }
+}
+
+typedef struct {
+  char *path; // full path, for the entries under it
+  size_t len;
+  size_t name; // offset of the last component in path
+  int depth;
+  DirHandle *parent; // NULL for the root, opened by path
+} DirTask;
+
+static void dir_task_free(DirTask *task) {
+  free(task->path);
+  dir_handle_release(task->parent);
+}
+
+typedef struct {
+  pthread_mutex_t lock;
+  DirTask *items;
+  size_t head, tail, cap;
+} Deque;
+
+static bool deque_push(Deque *q, DirTask task) {
+  pthread_mutex_lock(&q->lock);
+  if (q->tail == q->cap) {
+    if (q->head > 0) { // compact before growing
+      memmove(q->items, q->items + q->head,
+              (q->tail - q->head) * sizeof *q->items);
+      q->tail -= q->head;
+      q->head = 0;
+    }
+    if (q->tail == q->cap) {
+      size_t cap = q->cap ? q->cap * 2 : 64;
+      DirTask *grown = realloc(q->items, cap * sizeof *grown);
+      if (!grown) {
+        pthread_mutex_unlock(&q->lock);
+        return false;
+      }
+      q->items = grown;
+      q->cap = cap;
+    }
+  }
+  q->items[q->tail++] = task;
+  pthread_mutex_unlock(&q->lock);
+  return true;
+}
+
+static bool deque_take(Deque *q, DirTask *task, bool steal) {
+  pthread_mutex_lock(&q->lock);
+  bool ok = q->head < q->tail;
+  if (ok)
+    *task = steal ? q->items[q->head++] : q->items[--q->tail];
+  if (q->head == q->tail)
+    q->head = q->tail = 0;
+  pthread_mutex_unlock(&q->lock);
+  return ok;
+}
+
+// ===== Walker =====
+
+typedef struct Walker Walker;
+
+typedef struct {
+  Walker *walker;
+  unsigned id;
+  Deque deque;
+  Batch *batch;
+  char *dents;
+  pthread_t thread;
+} Worker;
+
+struct Walker {
+  WalkOptions options;
+  unsigned nworkers;
+  Worker *workers;
+  atomic_size_t pending; // directories queued or being read
+  atomic_size_t waiting; // directories in the deques
+  atomic_size_t errors;
+  atomic_uint live;      // workers still running
+  atomic_bool stop;
+
+  // Workers with nothing to steal sleep here until a push, the end of the
+  // walk or a stop.
+  pthread_mutex_t idle_lock;
+  pthread_cond_t idle_cond;
+  atomic_uint sleepers;
+
+  // Push mode (dir_walk)
+  WalkCallback callback;
+  void *user;
+  pthread_mutex_t emit_lock;
+
+  // Pull mode (dirwalk_open)
+  bool pull;
+  pthread_mutex_t queue_lock;
+  pthread_cond_t queue_cond;
+  Batch *queue_head, *queue_tail, *free_list;
+  size_t queued;
+  bool done;    // all workers finished
+  bool closing; // reader went away
+};
+
+static void walker_wake_all(Walker *w) {
+  pthread_mutex_lock(&w->idle_lock);
+  pthread_cond_broadcast(&w->idle_cond);
+  pthread_mutex_unlock(&w->idle_lock);
+}
+
+static void walker_stop(Walker *w) {
+  atomic_store(&w->stop, true);
+  walker_wake_all(w);
+}
+
+// Hands the worker's batch on and leaves *slot ready for more entries.
+// Returns false when the walk should stop.
+static bool walker_emit(Walker *w, Batch **slot) {
+  Batch *b = *slot;
+  if (!w->pull) {
+    pthread_mutex_lock(&w->emit_lock);
+    bool more = !atomic_load(&w->stop) && w->callback(&b->view, w->user);
+    pthread_mutex_unlock(&w->emit_lock);
+    batch_reset(b);
+    if (!more)
+      walker_stop(w);
+    return more;
+  }
+
+  pthread_mutex_lock(&w->queue_lock);
+  while (w->queued >= QUEUE_BATCHES && !w->closing)
+    pthread_cond_wait(&w->queue_cond, &w->queue_lock);
+  if (w->closing) {
+    pthread_mutex_unlock(&w->queue_lock);
+    batch_reset(b);
+    walker_stop(w);
+    return false;
+  }
+  b->next = NULL;
+  if (w->queue_tail)
+    w->queue_tail->next = b;
+  else
+    w->queue_head = b;
+  w->queue_tail = b;
+  w->queued++;
+  pthread_cond_broadcast(&w->queue_cond);
+
+  Batch *fresh = w->free_list;
+  if (fresh)
+    w->free_list = fresh->next;
+  pthread_mutex_unlock(&w->queue_lock);
+  if (!fresh)
+    fresh = batch_new();
+  *slot = fresh;
+  if (!fresh) {
+    walker_stop(w);
+    return false;
+  }
+  batch_reset(fresh);
+  return true;
+}
+
+static WalkType type_from_dirent(unsigned char d_type) {
+  switch (d_type) {
+  case DT_REG:
+    return WALK_FILE;
+  case DT_DIR:
+    return WALK_DIR;
+  case DT_LNK:
+    return WALK_SYMLINK;
+  default:
+    return WALK_OTHER;
+  }
+}
+
+static WalkType type_from_mode(mode_t mode) {
+  if (S_ISREG(mode))
+    return WALK_FILE;
+  if (S_ISDIR(mode))
+    return WALK_DIR;
+  if (S_ISLNK(mode))
+    return WALK_SYMLINK;
+  return WALK_OTHER;
+}
+
+static void walk_entry(Worker *wk, DirHandle *dirh, const DirTask *dir,
+                       const char *name, unsigned char d_type) {
+  Walker *w = wk->walker;
+  WalkType type = type_from_dirent(d_type);
+  int64_t size = -1, mtime_ns = -1;
+
+  // d_type answers everything but size/mtime; only filesystems that
+  // report DT_UNKNOWN pay for a statx without WalkOptions.stat.
+  if (w->options.stat || d_type == DT_UNKNOWN) {
+    struct statx stx;
+    unsigned mask = STATX_TYPE;
+    if (w->options.stat)
+      mask |= STATX_SIZE | STATX_MTIME;
+    if (statx(dirh->fd, name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT, mask,
+              &stx) != 0) {
+      atomic_fetch_add(&w->errors, 1);
+      return; // vanished since getdents
+    }
+    type = type_from_mode(stx.stx_mode);
+    if (w->options.stat) {
+      size = (int64_t)stx.stx_size;
+      mtime_ns = (int64_t)stx.stx_mtime.tv_sec * 1000000000 +
+                 stx.stx_mtime.tv_nsec;
+    }
+  }
+
+  // Join "dir/name"; the root "/" needs no separator.
+  size_t name_len = strlen(name);
+  bool slash = !(dir->len > 0 && dir->path[dir->len - 1] == '/');
+  size_t len = dir->len + slash + name_len;
+  Batch *b = wk->batch;
+  if (b->view.count == BATCH_ENTRIES ||
+      b->path_used + len + 1 > BATCH_PATH_BYTES) {
+    if (!walker_emit(w, &wk->batch))
+      return;
+    b = wk->batch;
+  }
+  char *path = b->paths + b->path_used;
+  memcpy(path, dir->path, dir->len);
+  if (slash)
+    path[dir->len] = '/';
+  memcpy(path + dir->len + slash, name, name_len + 1);
+  b->path_used += len + 1;
+
+  int depth = dir->depth + 1;
+  b->entries[b->view.count++] = (WalkEntry){
+      .path = path,
+      .path_len = (uint32_t)len,
+      .type = (uint8_t)type,
+      .depth = (uint16_t)depth,
+      .size = size,
+      .mtime_ns = mtime_ns,
+  };
+
+  if (type != WALK_DIR ||
+      (w->options.max_depth >= 0 && depth >= w->options.max_depth))
+    return;
+  DirTask task = {.path = malloc(len + 1),
+                  .len = len,
+                  .name = dir->len + slash,
+                  .depth = depth,
+                  .parent = dirh};
+  if (!task.path) {
+    atomic_fetch_add(&w->errors, 1);
+    return;
+  }
+  memcpy(task.path, path, len + 1);
+  atomic_fetch_add(&dirh->refs, 1);
+  atomic_fetch_add(&w->pending, 1); // before the task becomes visible
+  atomic_fetch_add(&w->waiting, 1);
+  if (!deque_push(&wk->deque, task)) {
+    dir_task_free(&task);
+    atomic_fetch_sub(&w->waiting, 1);
+    atomic_fetch_sub(&w->pending, 1);
+    atomic_fetch_add(&w->errors, 1);
+    return;
+  }
+  if (atomic_load(&w->sleepers) > 0) {
+    pthread_mutex_lock(&w->idle_lock);
+    pthread_cond_signal(&w->idle_cond);
+    pthread_mutex_unlock(&w->idle_lock);
+  }
+}
+
+static void walk_dir(Worker *wk, const DirTask *dir) {
+  Walker *w = wk->walker;
+  int fd = dir->parent ? openat(dir->parent->fd, dir->path + dir->name,
+                                O_RDONLY | O_DIRECTORY | O_NOFOLLOW |
+                                    O_CLOEXEC)
+                       : open(dir->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  DirHandle *h = fd >= 0 ? malloc(sizeof *h) : NULL;
+  if (!h) {
+    if (fd >= 0)
+      close(fd);
+    atomic_fetch_add(&w->errors, 1);
+    return;
+  }
+  h->fd = fd;
+  atomic_init(&h->refs, 1);
+  while (!atomic_load_explicit(&w->stop, memory_order_relaxed)) {
+    long n = syscall(SYS_getdents64, fd, wk->dents, DENTS_BYTES);
+    if (n <= 0) {
+      if (n < 0)
+        atomic_fetch_add(&w->errors, 1);
+      break;
+    }
+    for (long off = 0; off < n && !atomic_load_explicit(
+                                      &w->stop, memory_order_relaxed);) {
+      struct linux_dirent64 *d = (void *)(wk->dents + off);
+      off += d->d_reclen;
+      const char *name = d->d_name;
+      if (name[0] == '.' &&
+          (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+        continue;
+      if (name[0] == '.' && !w->options.hidden)
+        continue;
+      walk_entry(wk, h, dir, name, d->d_type);
+    }
+  }
+  dir_handle_release(h);
+}
+
+// Drops count workers from w->live; whoever drops the last one ends a pull
+// walk, so dirwalk_next stops waiting.
+static void walker_retire(Walker *w, unsigned count) {
+  if (atomic_fetch_sub(&w->live, count) == count && w->pull) {
+    pthread_mutex_lock(&w->queue_lock);
+    w->done = true;
+    pthread_cond_broadcast(&w->queue_cond);
+    pthread_mutex_unlock(&w->queue_lock);
+  }
+}
+
+static void *worker_main(void *arg) {
+  Worker *wk = arg;
+  Walker *w = wk->walker;
+
+  // Tasks left queued after a stop are freed by walker_free.
+  while (atomic_load(&w->pending) > 0 && !atomic_load(&w->stop)) {
+    DirTask task;
+    bool found = deque_take(&wk->deque, &task, false);
+    for (unsigned i = 1; !found && i < w->nworkers; i++)
+      found = deque_take(&w->workers[(wk->id + i) % w->nworkers].deque,
+                         &task, true);
+    if (!found) {
+      // Someone is still reading a directory that may yield more work.
+      // sleepers is raised before waiting is checked and a pusher raises
+      // waiting before checking sleepers, so one of the two sees the other.
+      pthread_mutex_lock(&w->idle_lock);
+      atomic_fetch_add(&w->sleepers, 1);
+      while (atomic_load(&w->waiting) == 0 && atomic_load(&w->pending) > 0 &&
+             !atomic_load(&w->stop))
+        pthread_cond_wait(&w->idle_cond, &w->idle_lock);
+      atomic_fetch_sub(&w->sleepers, 1);
+      pthread_mutex_unlock(&w->idle_lock);
+      continue;
+    }
+    atomic_fetch_sub(&w->waiting, 1);
+    walk_dir(wk, &task);
+    dir_task_free(&task);
+    if (atomic_fetch_sub(&w->pending, 1) == 1)
+      walker_wake_all(w);
+  }
+
+  if (wk->batch && wk->batch->view.count > 0 && !atomic_load(&w->stop))
+    walker_emit(w, &wk->batch);
+
+  walker_retire(w, 1);
+  return NULL;
+}
+
+static void walker_free(Walker *w) {
+  for (unsigned i = 0; i < w->nworkers; i++) {
+    Worker *wk = &w->workers[i];
+    for (size_t t = wk->deque.head; t < wk->deque.tail; t++)
+      dir_task_free(&wk->deque.items[t]);
+    free(wk->deque.items);
+    pthread_mutex_destroy(&wk->deque.lock);
+    free(wk->batch);
+    free(wk->dents);
+  }
+  free(w->workers);
+  for (Batch *b = w->queue_head, *next; b; b = next) {
+    next = b->next;
+    free(b);
+  }
+  for (Batch *b = w->free_list, *next; b; b = next) {
+    next = b->next;
+    free(b);
+  }
+  pthread_mutex_destroy(&w->emit_lock);
+  pthread_mutex_destroy(&w->queue_lock);
+  pthread_cond_destroy(&w->queue_cond);
+  pthread_mutex_destroy(&w->idle_lock);
+  pthread_cond_destroy(&w->idle_cond);
+  free(w);
+}
+
+// Sets up the walker with the root queued on worker 0. Returns 0 or errno.
+static int walker_init(Walker **out, const char *root, WalkOptions options) {
+  int fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0)
+    return errno;
+  close(fd);
+
+  Walker *w = calloc(1, sizeof *w);
+  if (!w)
+    return ENOMEM;
+  w->options = options;
+  w->nworkers = options.threads;
+  if (w->nworkers == 0) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    w->nworkers = n > 0 ? (unsigned)n : 1;
+  }
+  if (w->nworkers > MAX_THREADS)
+    w->nworkers = MAX_THREADS;
+  pthread_mutex_init(&w->emit_lock, NULL);
+  pthread_mutex_init(&w->queue_lock, NULL);
+  pthread_cond_init(&w->queue_cond, NULL);
+  pthread_mutex_init(&w->idle_lock, NULL);
+  pthread_cond_init(&w->idle_cond, NULL);
+
+  w->workers = calloc(w->nworkers, sizeof *w->workers);
+  bool ok = w->workers != NULL;
+  for (unsigned i = 0; ok && i < w->nworkers; i++) {
+    Worker *wk = &w->workers[i];
+    wk->walker = w;
+    wk->id = i;
+    pthread_mutex_init(&wk->deque.lock, NULL);
+    wk->batch = batch_new();
+    wk->dents = malloc(DENTS_BYTES);
+    ok = wk->batch && wk->dents;
+  }
+
+  // Trailing slashes would double up in joined paths ("/" stays).
+  size_t len = strlen(root);
+  while (len > 1 && root[len - 1] == '/')
+    len--;
+  DirTask task = {.path = strndup(root, len), .len = len, .depth = 0};
+  if (!ok || !task.path || !deque_push(&w->workers[0].deque, task)) {
+    free(task.path);
+    if (!w->workers)
+      w->nworkers = 0;
+    walker_free(w);
+    return ENOMEM;
+  }
+  atomic_init(&w->pending, 1);
+  atomic_init(&w->waiting, 1);
+  atomic_init(&w->live, w->nworkers);
+  *out = w;
+  return 0;
+}
+
+// Starts workers first..nworkers-1; returns how many threads started.
+static unsigned walker_spawn(Walker *w, unsigned first) {
+  unsigned started = 0;
+  for (unsigned i = first; i < w->nworkers; i++) {
+    if (pthread_create(&w->workers[i].thread, NULL, worker_main,
+                       &w->workers[i]) != 0)
+      break;
+    started++;
+  }
+  // Workers that failed to start never run; the others cover their deques.
+  // The started ones may all have finished by now, in which case this ends
+  // the walk.
+  unsigned missing = w->nworkers - first - started;
+  if (missing > 0)
+    walker_retire(w, missing);
+  return started;
+}
+
+int dir_walk(const char *root, WalkOptions options, WalkCallback callback,
+             void *user, size_t *errors) {
+  Walker *w;
+  int err = walker_init(&w, root, options);
+  if (err)
+    return err;
+  w->callback = callback;
+  w->user = user;
+
+  unsigned started = walker_spawn(w, 1);
+  worker_main(&w->workers[0]); // the caller is worker 0
+  for (unsigned i = 1; i <= started; i++)
+    pthread_join(w->workers[i].thread, NULL);
+
+  if (errors)
+    *errors = atomic_load(&w->errors);
+  walker_free(w);
+  return 0;
+}
+
+// ===== C ABI (Dart FFI) =====
+
+struct DirWalk {
+  Walker *walker;
+  Batch *current; // handed to the reader, recycled on the next call
+  unsigned started;
+  int error;
+};
+
+DirWalk *dirwalk_open(const char *root, uint32_t threads, int32_t max_depth,
+                      uint32_t flags) {
+  DirWalk *walk = calloc(1, sizeof *walk);
+  if (!walk)
+    return NULL;
+  WalkOptions options = {.threads = threads,
+                         .max_depth = max_depth,
+                         .stat = flags & DIRWALK_STAT,
+                         .hidden = flags & DIRWALK_HIDDEN};
+  walk->error = walker_init(&walk->walker, root, options);
+  if (walk->error)
+    return walk; // reported by dirwalk_next (NULL) and dirwalk_close
+
+  Walker *w = walk->walker;
+  w->pull = true;
+  walk->started = walker_spawn(w, 0);
+  if (walk->started == 0) {
+    pthread_mutex_lock(&w->queue_lock);
+    w->done = true;
+    pthread_mutex_unlock(&w->queue_lock);
+    walk->error = EAGAIN;
+  }
+  return walk;
+}
+
+const WalkBatch *dirwalk_next(DirWalk *walk) {
+  Walker *w = walk->walker;
+  if (!w)
+    return NULL;
+  pthread_mutex_lock(&w->queue_lock);
+  if (walk->current) {
+    walk->current->next = w->free_list;
+    w->free_list = walk->current;
+    walk->current = NULL;
+  }
+  while (!w->queue_head && !w->done)
+    pthread_cond_wait(&w->queue_cond, &w->queue_lock);
+  Batch *b = w->queue_head;
+  if (b) {
+    w->queue_head = b->next;
+    if (!w->queue_head)
+      w->queue_tail = NULL;
+    w->queued--;
+    pthread_cond_broadcast(&w->queue_cond); // room for producers
+  }
+  pthread_mutex_unlock(&w->queue_lock);
+  walk->current = b;
+  return b ? &b->view : NULL;
+}
+
+int dirwalk_close(DirWalk *walk) {
+  if (!walk)
+    return 0;
+  int error = walk->error;
+  Walker *w = walk->walker;
+  if (w) {
+    walker_stop(w);
+    pthread_mutex_lock(&w->queue_lock);
+    w->closing = true;
+    pthread_cond_broadcast(&w->queue_cond);
+    pthread_mutex_unlock(&w->queue_lock);
+    for (unsigned i = 0; i < walk->started; i++)
+      pthread_join(w->workers[i].thread, NULL);
+    free(walk->current);
+    walker_free(w);
+  }
+  free(walk);
+  return error;
+}
@@ -0,0 +1,65 @@
+// dirwalk.h — parallel directory walker (Linux, getdents64)
+#ifndef DIRWALK_H
+#define DIRWALK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+  WALK_FILE,
+  WALK_DIR,
+  WALK_SYMLINK, // reported, never followed
+  WALK_OTHER,   // fifo, socket, device
+} WalkType;
+
+// Paths are root-joined ("root/a/b.txt") and NUL-terminated. size and
+// mtime_ns are -1 unless WalkOptions.stat is set.
+typedef struct {
+  const char *path;
+  uint32_t path_len;
+  uint8_t type; // WalkType
+  uint16_t depth; // 1 for the root's children
+  int64_t size;
+  int64_t mtime_ns;
+} WalkEntry;
+
+typedef struct {
+  size_t count;
+  const WalkEntry *entries;
+} WalkBatch;
+
+typedef struct {
+  unsigned threads; // 0: one per online CPU
+  int max_depth;    // < 0: unlimited
+  bool stat;        // fill size/mtime with statx (types come from d_type)
+  bool hidden;      // include dot files and descend into dot directories
+} WalkOptions;
+
+#define DEFAULT_WALK_OPTIONS                                                   \
+  {.threads = 0, .max_depth = -1, .stat = false, .hidden = true}
+
+// Called with batches of entries, one call at a time (the walker
+// serializes them), from the worker threads. Entries are only valid during
+// the call. Return false to stop the walk early.
+typedef bool (*WalkCallback)(const WalkBatch *batch, void *user);
+
+// Returns 0, or the errno that kept the root from being opened.
+// Unreadable subdirectories are skipped and counted in *errors if given.
+int dir_walk(const char *root, WalkOptions options, WalkCallback callback,
+             void *user, size_t *errors);
+
+// ===== C ABI (Dart FFI) =====
+// Pull interface: the walk runs in the background and dirwalk_next hands
+// out batches, each valid until the next call. Returns NULL at the end.
+typedef struct DirWalk DirWalk;
+
+DirWalk *dirwalk_open(const char *root, uint32_t threads, int32_t max_depth,
+                      uint32_t flags);
+const WalkBatch *dirwalk_next(DirWalk *walk);
+int dirwalk_close(DirWalk *walk); // same result as dir_walk
+
+#define DIRWALK_STAT 1u
+#define DIRWALK_HIDDEN 2u
+
+#endif
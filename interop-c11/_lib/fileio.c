@@ -1,39 +1,1645 @@
 // fileio.c
+#define _GNU_SOURCE
 #include "fileio.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FILEIO_X86 1
+#endif
+
+// Reads until size bytes or EOF; short counts only at the end of the file.
+static ssize_t read_full(int fd, char *buf, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = read(fd, buf + done, size - done);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return -1;
+    }
+    if (n == 0)
+      break;
+    done += (size_t)n;
+  }
+  return (ssize_t)done;
+}
+
+// Reads fd to EOF into a growing heap buffer (NUL-terminated).
+static bool file_read_stream(int fd, FileView *view) {
+  size_t cap = 4096;
+  size_t len = 0;
+  char *buf = malloc(cap);
+  if (!buf)
+    return false;
+  for (;;) {
+    if (len + 1 == cap) {
+      char *grown = realloc(buf, cap * 2);
+      if (!grown) {
+        free(buf);
+        return false;
+      }
+      buf = grown;
+      cap *= 2;
+    }
+    ssize_t n = read(fd, buf + len, cap - len - 1);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      free(buf);
+      return false;
+    }
+    if (n == 0)
+      break;
+    len += (size_t)n;
+  }
+  buf[len] = '\0';
+  *view = (FileView){.data = buf, .size = len, .mapped = false};
+  return true;
+}
+
+bool file_map(const char *path, FileView *view) {
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int saved = errno;
+    close(fd);
+    errno = saved;
+    return false;
+  }
+
+  // procfs and sysfs report size 0, pipes have no size: read those instead.
+  bool ok;
+  if (S_ISREG(st.st_mode) && st.st_size > 0) {
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ok = data != MAP_FAILED;
+    if (ok) {
+      madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+      madvise(data, (size_t)st.st_size, MADV_WILLNEED);
+      *view = (FileView){
+          .data = data, .size = (size_t)st.st_size, .mapped = true};
+    }
+  } else {
+    ok = file_read_stream(fd, view);
+  }
+
+  int saved = errno;
+  close(fd); // the mapping stays valid
+  errno = saved;
+  return ok;
+}
+
+void file_unmap(FileView *view) {
+  if (view->mapped)
+    munmap((void *)view->data, view->size);
+  else
+    free((void *)view->data);
+  *view = (FileView){0};
+}
 
 char *file_read_text(const char *path) {
-  FILE *f = fopen(path, "rb");
-  if (!f)
+  FileResult result = read_file(path);
+  if (!result.is_success) {
+    errno = result.sys_errno ? result.sys_errno : ENOMEM;
+    return NULL;
+  }
+  return result.value;
+}
+
+// ===== Results =====
+
+FileError file_error_from_errno(int err) {
+  switch (err) {
+  case 0:
+    return FILE_OK;
+  case ENOENT:
+  case ENOTDIR:
+    return FILE_ERR_NOT_FOUND;
+  case EACCES:
+  case EPERM:
+  case EROFS:
+    return FILE_ERR_PERMISSION;
+  case EISDIR:
+    return FILE_ERR_IS_DIRECTORY;
+  case ENOMEM:
+    return FILE_ERR_NO_MEMORY;
+  case EILSEQ:
+    return FILE_ERR_ENCODING;
+  default:
+    return FILE_ERR_IO;
+  }
+}
+
+const char *file_error_name(FileError error) {
+  switch (error) {
+  case FILE_OK:
+    return "ok";
+  case FILE_ERR_NOT_FOUND:
+    return "not found";
+  case FILE_ERR_PERMISSION:
+    return "permission denied";
+  case FILE_ERR_IS_DIRECTORY:
+    return "is a directory";
+  case FILE_ERR_NO_SPACE:
+    return "buffer too small";
+  case FILE_ERR_NO_MEMORY:
+    return "out of memory";
+  case FILE_ERR_ENCODING:
+    return "invalid encoding";
+  case FILE_ERR_IO:
+    return "I/O error";
+  }
+  return "unknown error";
+}
+
+size_t result_format_error(Result result, char *buf, size_t size) {
+  int n;
+  if (result.sys_errno) {
+    char sys[128];
+    n = snprintf(buf, size, "%s: %s", file_error_name(result.error),
+                 strerror_r(result.sys_errno, sys, sizeof sys));
+  } else {
+    n = snprintf(buf, size, "%s", file_error_name(result.error));
+  }
+  return n > 0 ? (size_t)n : 0;
+}
+
+void free_result(Result result) {
+  if (result.is_success)
+    free(result.value);
+}
+
+char *result_to_string(Result result) {
+  char text[256], error[192];
+  if (result.is_success) {
+    snprintf(text, sizeof text, "Success(%p, %zu bytes)", result.value,
+             result.size);
+  } else {
+    result_format_error(result, error, sizeof error);
+    snprintf(text, sizeof text, "Failure(%s)", error);
+  }
+  return strdup(text);
+}
+
+void *arena_alloc(FileArena *arena, size_t size) {
+  size_t start = (arena->used + 15) & ~(size_t)15;
+  if (start > arena->size || size > arena->size - start)
     return NULL;
+  arena->used = start + size;
+  return arena->base + start;
+}
+
+void arena_reset(FileArena *arena) { arena->used = 0; }
+
+// ===== Text encoding =====
+
+// Length of the well-formed UTF-8 sequence at s (Unicode table 3-7), or 0.
+static size_t utf8_sequence(const unsigned char *s, size_t n) {
+  unsigned char c = s[0];
+  if (c < 0x80)
+    return 1;
+  if (c < 0xC2 || c > 0xF4)
+    return 0;
+  if (c < 0xE0)
+    return n >= 2 && (s[1] & 0xC0) == 0x80 ? 2 : 0;
+  unsigned char lo = c == 0xE0 ? 0xA0 : c == 0xF0 ? 0x90 : 0x80;
+  unsigned char hi = c == 0xED ? 0x9F : c == 0xF4 ? 0x8F : 0xBF;
+  size_t len = c < 0xF0 ? 3 : 4;
+  if (n < len || s[1] < lo || s[1] > hi)
+    return 0;
+  for (size_t i = 2; i < len; i++)
+    if ((s[i] & 0xC0) != 0x80)
+      return 0;
+  return len;
+}
+
+// Offset of the first invalid byte, or size. Skips ASCII a word at a time.
+static size_t utf8_valid_prefix(const char *data, size_t size) {
+  const unsigned char *s = (const unsigned char *)data;
+  size_t i = 0;
+  while (i < size) {
+    uint64_t word;
+    if (i + 8 <= size) {
+      memcpy(&word, s + i, 8);
+      if (!(word & 0x8080808080808080u)) {
+        i += 8;
+        continue;
+      }
+    }
+    size_t len = utf8_sequence(s + i, size - i);
+    if (len == 0)
+      return i;
+    i += len;
+  }
+  return size;
+}
+
+#ifdef FILEIO_X86
+// Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per
+// Byte": three nibble lookups classify every byte pair, and the lead bytes
+// two and three positions back say where continuations must be.
+enum {
+  U8_TOO_SHORT = 1 << 0,
+  U8_TOO_LONG = 1 << 1,
+  U8_OVERLONG_3 = 1 << 2,
+  U8_TOO_LARGE = 1 << 3,
+  U8_SURROGATE = 1 << 4,
+  U8_OVERLONG_2 = 1 << 5,
+  U8_TOO_LARGE_1000 = 1 << 6,
+  U8_OVERLONG_4 = 1 << 6,
+  U8_TWO_CONTS = -0x80, // bit 7, as the (signed) char the tables hold
+  U8_CARRY = U8_TOO_SHORT | U8_TOO_LONG | U8_TWO_CONTS,
+};
+
+#define U8_TABLE(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+__attribute__((target("avx2"))) static inline __m256i
+u8_prev(__m256i input, __m256i prev, int n) {
+  __m256i joined = _mm256_permute2x128_si256(prev, input, 0x21);
+  switch (n) {
+  case 1:
+    return _mm256_alignr_epi8(input, joined, 15);
+  case 2:
+    return _mm256_alignr_epi8(input, joined, 14);
+  default:
+    return _mm256_alignr_epi8(input, joined, 13);
+  }
+}
+
+__attribute__((target("avx2"))) static bool utf8_validate_avx2(const char *data,
+                                                              size_t size) {
+  const __m256i byte_1_high_table = U8_TABLE(
+      U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG,
+      U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG, U8_TWO_CONTS, U8_TWO_CONTS,
+      U8_TWO_CONTS, U8_TWO_CONTS, U8_TOO_SHORT | U8_OVERLONG_2, U8_TOO_SHORT,
+      U8_TOO_SHORT | U8_OVERLONG_3 | U8_SURROGATE,
+      U8_TOO_SHORT | U8_TOO_LARGE | U8_TOO_LARGE_1000 | U8_OVERLONG_4);
+  const char large = U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000;
+  const __m256i byte_1_low_table = U8_TABLE(
+      U8_CARRY | U8_OVERLONG_3 | U8_OVERLONG_2 | U8_OVERLONG_4,
+      U8_CARRY | U8_OVERLONG_2, U8_CARRY, U8_CARRY, U8_CARRY | U8_TOO_LARGE,
+      large, large, large, large, large, large, large, large,
+      large | U8_SURROGATE, large, large);
+  const char cont = U8_TOO_LONG | U8_OVERLONG_2 | U8_TWO_CONTS;
+  const __m256i byte_2_high_table = U8_TABLE(
+      U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT,
+      U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT,
+      cont | U8_OVERLONG_3 | U8_TOO_LARGE_1000 | U8_OVERLONG_4,
+      cont | U8_OVERLONG_3 | U8_TOO_LARGE, cont | U8_SURROGATE | U8_TOO_LARGE,
+      cont | U8_SURROGATE | U8_TOO_LARGE, U8_TOO_SHORT, U8_TOO_SHORT,
+      U8_TOO_SHORT, U8_TOO_SHORT);
+  // Any of the last three bytes opening a longer sequence than fits.
+  const __m256i max_value = _mm256_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1),
+      (char)(0xE0 - 1), (char)(0xC0 - 1));
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+  __m256i error = _mm256_setzero_si256();
+  __m256i prev_input = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+
+  for (size_t i = 0; i < size; i += 32) {
+    __m256i input;
+    if (i + 32 <= size) {
+      input = _mm256_loadu_si256((const __m256i *)(data + i));
+    } else {
+      char tail[32] = {0}; // NUL padding is ASCII
+      memcpy(tail, data + i, size - i);
+      input = _mm256_loadu_si256((const __m256i *)tail);
+    }
+
+    if (_mm256_movemask_epi8(input) == 0) { // all ASCII
+      error = _mm256_or_si256(error, prev_incomplete);
+      prev_incomplete = _mm256_setzero_si256();
+      prev_input = input;
+      continue;
+    }
 
-  fseek(f, 0, SEEK_END);
-  long len = ftell(f);
-  rewind(f);
+    __m256i prev1 = u8_prev(input, prev_input, 1);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(byte_1_high_table,
+                                _mm256_and_si256(_mm256_srli_epi16(prev1, 4),
+                                                 nibble)),
+            _mm256_shuffle_epi8(byte_1_low_table,
+                                _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(
+            byte_2_high_table,
+            _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
 
-  char *buffer = malloc(len + 1);
-  if (!buffer) {
-    fclose(f);
+    __m256i prev2 = u8_prev(input, prev_input, 2);
+    __m256i prev3 = u8_prev(input, prev_input, 3);
+    __m256i must23 = _mm256_or_si256(
+        _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80))),
+        _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80))));
+    __m256i must23_80 = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+    error = _mm256_or_si256(error, _mm256_xor_si256(must23_80, special));
+
+    prev_incomplete = _mm256_subs_epu8(input, max_value);
+    prev_input = input;
+  }
+  error = _mm256_or_si256(error, prev_incomplete);
+  return _mm256_testz_si256(error, error);
+}
+#endif
+
+bool utf8_validate(const char *data, size_t size) {
+#ifdef FILEIO_X86
+  if (__builtin_cpu_supports("avx2"))
+    return utf8_validate_avx2(data, size);
+#endif
+  return utf8_valid_prefix(data, size) == size;
+}
+
+// Appends code point cp to out (which has room) and returns the new end.
+static char *utf8_put(char *out, uint32_t cp) {
+  if (cp < 0x80) {
+    *out++ = (char)cp;
+  } else if (cp < 0x800) {
+    *out++ = (char)(0xC0 | cp >> 6);
+    *out++ = (char)(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    *out++ = (char)(0xE0 | cp >> 12);
+    *out++ = (char)(0x80 | (cp >> 6 & 0x3F));
+    *out++ = (char)(0x80 | (cp & 0x3F));
+  } else {
+    *out++ = (char)(0xF0 | cp >> 18);
+    *out++ = (char)(0x80 | (cp >> 12 & 0x3F));
+    *out++ = (char)(0x80 | (cp >> 6 & 0x3F));
+    *out++ = (char)(0x80 | (cp & 0x3F));
+  }
+  return out;
+}
+
+char *utf8_repair(const char *data, size_t size, size_t *out_size) {
+  char *buf = malloc(size * 3 + 1); // every byte may become U+FFFD
+  if (!buf)
     return NULL;
+  char *out = buf;
+  size_t i = 0;
+  while (i < size) {
+    size_t valid = utf8_valid_prefix(data + i, size - i);
+    memcpy(out, data + i, valid);
+    out += valid;
+    i += valid;
+    if (i < size) {
+      out = utf8_put(out, 0xFFFD);
+      i++;
+    }
   }
+  *out = '\0';
+  *out_size = (size_t)(out - buf);
+  char *shrunk = realloc(buf, *out_size + 1);
+  return shrunk ? shrunk : buf;
+}
 
-  size_t read_len = fread(buffer, 1, len, f);
-  buffer[read_len] = '\0';
-  fclose(f);
+static char *latin1_to_utf8(const unsigned char *s, size_t size,
+                            size_t *out_size) {
+  char *buf = malloc(size * 2 + 1);
+  if (!buf)
+    return NULL;
+  char *out = buf;
+  for (size_t i = 0; i < size; i++)
+    out = utf8_put(out, s[i]);
+  *out = '\0';
+  *out_size = (size_t)(out - buf);
+  return buf;
+}
 
-  return buffer;
+// Unpaired surrogates become U+FFFD; an odd trailing byte is dropped.
+static char *utf16_to_utf8(const unsigned char *s, size_t size, bool big,
+                           size_t *out_size) {
+  size_t units = size / 2;
+  char *buf = malloc(units * 3 + 1);
+  if (!buf)
+    return NULL;
+  char *out = buf;
+  for (size_t i = 0; i < units; i++) {
+    uint32_t u = big ? (uint32_t)(s[2 * i] << 8 | s[2 * i + 1])
+                     : (uint32_t)(s[2 * i + 1] << 8 | s[2 * i]);
+    if (u >= 0xD800 && u <= 0xDBFF && i + 1 < units) {
+      uint32_t lo = big ? (uint32_t)(s[2 * i + 2] << 8 | s[2 * i + 3])
+                        : (uint32_t)(s[2 * i + 3] << 8 | s[2 * i + 2]);
+      if (lo >= 0xDC00 && lo <= 0xDFFF) {
+        out = utf8_put(out, 0x10000 + ((u - 0xD800) << 10) + (lo - 0xDC00));
+        i++;
+        continue;
+      }
+    }
+    out = utf8_put(out, u >= 0xD800 && u <= 0xDFFF ? 0xFFFD : u);
+  }
+  *out = '\0';
+  *out_size = (size_t)(out - buf);
+  return buf;
 }
 
-int file_write_text(const char *path, const char *text) {
-  FILE *f = fopen(path, "wb");
-  if (!f)
-    return 1; // error
+// Turns the view's bytes into UTF-8 per options. A view that needs no
+// change is left alone (mapped views stay mapped); otherwise it is
+// replaced by a heap copy.
+static FileError decode_view(FileView *view, ReadOptions options) {
+  const char *enc = options.encoding;
+  if (!enc || strcasecmp(enc, "BINARY") == 0)
+    return FILE_OK;
+
+  const unsigned char *s = (const unsigned char *)view->data;
+  size_t size = view->size;
+  char *text = NULL;
+  size_t text_size = 0;
+
+  if (strcasecmp(enc, "UTF-8") == 0 || strcasecmp(enc, "UTF8") == 0) {
+    size_t bom = size >= 3 && s[0] == 0xEF && s[1] == 0xBB && s[2] == 0xBF;
+    bom *= 3;
+    bool valid = utf8_validate(view->data + bom, size - bom);
+    if (valid && !bom)
+      return FILE_OK;
+    if (!valid && !options.repair_utf8)
+      return FILE_ERR_ENCODING;
+    if (valid) {
+      text = malloc(size - bom + 1);
+      if (text) {
+        memcpy(text, view->data + bom, size - bom);
+        text[text_size = size - bom] = '\0';
+      }
+    } else {
+      text = utf8_repair(view->data + bom, size - bom, &text_size);
+    }
+  } else if (strcasecmp(enc, "LATIN-1") == 0 ||
+             strcasecmp(enc, "LATIN1") == 0 ||
+             strcasecmp(enc, "ISO-8859-1") == 0) {
+    text = latin1_to_utf8(s, size, &text_size);
+  } else if (strncasecmp(enc, "UTF-16", 6) == 0) {
+    bool big = strcasecmp(enc + 6, "BE") == 0;
+    if (enc[6] && !big && strcasecmp(enc + 6, "LE") != 0)
+      return FILE_ERR_ENCODING;
+    size_t skip = 0;
+    if (!enc[6] && size >= 2 &&
+        ((s[0] == 0xFF && s[1] == 0xFE) || (s[0] == 0xFE && s[1] == 0xFF))) {
+      big = s[0] == 0xFE;
+      skip = 2;
+    }
+    text = utf16_to_utf8(s + skip, size - skip, big, &text_size);
+  } else {
+    return FILE_ERR_ENCODING;
+  }
+
+  if (!text)
+    return FILE_ERR_NO_MEMORY;
+  file_unmap(view);
+  *view = (FileView){.data = text, .size = text_size, .mapped = false};
+  return FILE_OK;
+}
+
+// ===== Line index =====
+
+typedef struct {
+  LineSpan *lines;
+  size_t count;
+  size_t capacity;
+  bool trim;
+  bool skip_empty;
+  bool failed;
+} LineBuilder;
+
+static inline bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Records [start, end) of data, applying the read options. Called once per
+// line from the scanners below; the common path is a compare and a store.
+static inline void line_builder_add(LineBuilder *b, const char *data,
+                                    size_t start, size_t end) {
+  if (b->trim) {
+    while (start < end && is_space(data[start]))
+      start++;
+    while (end > start && is_space(data[end - 1]))
+      end--;
+  } else if (end > start && data[end - 1] == '\r') {
+    end--; // CRLF terminator
+  }
+  if (b->skip_empty && start == end)
+    return;
+
+  if (b->count == b->capacity) {
+    size_t capacity = b->capacity * 2;
+    LineSpan *grown = realloc(b->lines, capacity * sizeof *grown);
+    if (!grown) {
+      b->failed = true;
+      return;
+    }
+    b->lines = grown;
+    b->capacity = capacity;
+  }
+  b->lines[b->count++] = (LineSpan){.offset = start, .length = end - start};
+}
+
+// Each scanner indexes every '\n' in data[*pos, size) up to its last full
+// block and advances *pos and *start; the caller finishes the tail.
+#ifdef FILEIO_X86
+__attribute__((target("avx2"))) static void
+scan_lines_avx2(LineBuilder *b, const char *data, size_t size, size_t *pos,
+                size_t *start) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  size_t i = *pos, line = *start;
+  for (; i + 32 <= size; i += 32) {
+    __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+    uint32_t mask =
+        (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline));
+    while (mask) {
+      size_t end = i + (size_t)__builtin_ctz(mask);
+      line_builder_add(b, data, line, end);
+      line = end + 1;
+      mask &= mask - 1;
+    }
+  }
+  *pos = i;
+  *start = line;
+}
+
+static void scan_lines_sse2(LineBuilder *b, const char *data, size_t size,
+                            size_t *pos, size_t *start) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  size_t i = *pos, line = *start;
+  for (; i + 16 <= size; i += 16) {
+    __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+    while (mask) {
+      size_t end = i + (size_t)__builtin_ctz(mask);
+      line_builder_add(b, data, line, end);
+      line = end + 1;
+      mask &= mask - 1;
+    }
+  }
+  *pos = i;
+  *start = line;
+}
+#endif
+
+static void scan_lines(LineBuilder *b, const char *data, size_t size) {
+  size_t pos = 0, start = 0;
+#ifdef FILEIO_X86
+  if (__builtin_cpu_supports("avx2"))
+    scan_lines_avx2(b, data, size, &pos, &start);
+  else
+    scan_lines_sse2(b, data, size, &pos, &start);
+#endif
+  // Tail (or the whole buffer elsewhere): glibc's memchr is vectorized too.
+  const char *nl;
+  while (pos < size && (nl = memchr(data + pos, '\n', size - pos))) {
+    size_t end = (size_t)(nl - data);
+    line_builder_add(b, data, start, end);
+    start = pos = end + 1;
+  }
+  if (start < size) // last line without a trailing newline
+    line_builder_add(b, data, start, size);
+}
+
+FileResult read_lines_with_options(const char *filename, ReadOptions options) {
+  LineIndex *index = calloc(1, sizeof *index);
+  if (!index)
+    return FAILURE(FILE_ERR_NO_MEMORY);
+  if (!file_map(filename, &index->view)) {
+    FileResult result = FAILURE_ERRNO(errno);
+    free(index);
+    return result;
+  }
+  FileError error = decode_view(&index->view, options);
+  if (error) {
+    free_lines(index);
+    return FAILURE(error);
+  }
+
+  // Guess ~64 bytes per line so typical logs never reallocate.
+  LineBuilder b = {.capacity = index->view.size / 64 + 16,
+                   .trim = options.trim_whitespace,
+                   .skip_empty = options.ignore_empty_lines};
+  b.lines = malloc(b.capacity * sizeof *b.lines);
+  if (b.lines)
+    scan_lines(&b, index->view.data, index->view.size);
+  if (!b.lines || b.failed) {
+    free(b.lines);
+    free_lines(index);
+    return FAILURE(FILE_ERR_NO_MEMORY);
+  }
+
+  index->lines = b.lines;
+  index->count = b.count;
+  FileResult result = SUCCESS(index);
+  result.size = sizeof *index;
+  return result;
+}
+
+FileResult read_lines(const char *filename) {
+  return read_lines_with_options(filename, (ReadOptions)DEFAULT_READ_OPTIONS);
+}
+
+void free_lines(LineIndex *index) {
+  if (!index)
+    return;
+  file_unmap(&index->view);
+  free(index->lines);
+  free(index);
+}
+
+// ===== Whole-file reads =====
+
+FileResult read_file(const char *filename) {
+  FileView view;
+  if (!file_map(filename, &view))
+    return FAILURE_ERRNO(errno);
+
+  size_t size = view.size;
+  char *data = (char *)view.data; // streams arrive as a heap copy already
+  if (view.mapped) {
+    data = malloc(size + 1);
+    if (data) {
+      memcpy(data, view.data, size);
+      data[size] = '\0';
+    }
+    file_unmap(&view);
+    if (!data)
+      return FAILURE(FILE_ERR_NO_MEMORY);
+  }
+  FileResult result = SUCCESS(data);
+  result.size = size;
+  return result;
+}
+
+// Applies the line options to a NUL-terminated buffer in place.
+static size_t filter_lines(char *data, size_t size, ReadOptions options) {
+  size_t out = 0, pos = 0;
+  while (pos < size) {
+    char *nl = memchr(data + pos, '\n', size - pos);
+    size_t start = pos, end = nl ? (size_t)(nl - data) : size;
+    pos = nl ? end + 1 : size;
+    if (options.trim_whitespace) {
+      while (start < end && is_space(data[start]))
+        start++;
+      while (end > start && is_space(data[end - 1]))
+        end--;
+    }
+    if (options.ignore_empty_lines && start == end)
+      continue;
+    memmove(data + out, data + start, end - start);
+    out += end - start;
+    if (nl)
+      data[out++] = '\n';
+  }
+  data[out] = '\0';
+  return out;
+}
+
+FileResult read_file_with_options(const char *filename, ReadOptions options) {
+  FileResult result = read_file(filename);
+  if (!result.is_success)
+    return result;
+
+  FileView view = {.data = result.value, .size = result.size};
+  FileError error = decode_view(&view, options);
+  if (error) {
+    file_unmap(&view);
+    return FAILURE(error);
+  }
+  result.value = (char *)view.data;
+  result.size = view.size;
+  if (options.trim_whitespace || options.ignore_empty_lines)
+    result.size = filter_lines(result.value, result.size, options);
+  return result;
+}
+
+FileResult read_file_into(const char *filename, FileArena *arena) {
+  int fd = open(filename, O_RDONLY | O_CLOEXEC);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    int err = errno;
+    if (fd >= 0)
+      close(fd);
+    return FAILURE_ERRNO(err);
+  }
+  if (S_ISDIR(st.st_mode)) {
+    close(fd);
+    return FAILURE_ERRNO(EISDIR);
+  }
+
+  // Sized files take exactly what they need; streams get the rest of the
+  // arena and fail if they fill it.
+  size_t mark = arena->used;
+  bool sized = S_ISREG(st.st_mode) && st.st_size > 0;
+  char *dst = arena_alloc(arena, sized ? (size_t)st.st_size + 1 : 1);
+  size_t cap = dst ? (size_t)(arena->base + arena->size - dst) - 1 : 0;
+  if (sized)
+    cap = (size_t)st.st_size;
+  ssize_t n = dst ? read_full(fd, dst, cap) : 0;
+  int err = n < 0 ? errno : 0;
+  close(fd);
+
+  if (!dst || n < 0 || (!sized && (size_t)n == cap)) {
+    arena->used = mark;
+    return n < 0 ? FAILURE_ERRNO(err) : FAILURE(FILE_ERR_NO_SPACE);
+  }
+  dst[n] = '\0';
+  arena->used = (size_t)(dst - arena->base) + (size_t)n + 1;
+  FileResult result = SUCCESS(dst);
+  result.size = (size_t)n;
+  return result;
+}
+
+// ===== Streaming reader =====
+
+typedef struct {
+  char *data;
+  size_t size;
+  int error;
+  bool full; // filled by the reader thread, not yet handed out
+} ReaderSlot;
+
+struct FileReader {
+  int fd;
+  size_t chunk_size;
+  int error;
+  bool eof;
+
+  // Chunk handed to the caller; next_line consumes it from pos.
+  const char *chunk;
+  size_t chunk_len;
+  size_t pos;
+
+  // A line that straddles chunks is assembled here.
+  char *carry;
+  size_t carry_len;
+  size_t carry_cap;
+  bool carry_returned;
+
+  // Synchronous readers only use slots[0].
+  ReaderSlot slots[2];
+  bool background;
+  int current; // slot held by the caller, -1 if none
+  int next;    // slot the caller takes next
+  bool stop;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+static void *reader_thread(void *arg) {
+  FileReader *r = arg;
+  for (int i = 0;; i ^= 1) {
+    ReaderSlot *slot = &r->slots[i];
+    pthread_mutex_lock(&r->lock);
+    while ((slot->full || r->current == i) && !r->stop)
+      pthread_cond_wait(&r->cond, &r->lock);
+    bool stop = r->stop;
+    pthread_mutex_unlock(&r->lock);
+    if (stop)
+      return NULL;
+
+    ssize_t n = read_full(r->fd, slot->data, r->chunk_size);
+    int error = n < 0 ? errno : 0;
+
+    pthread_mutex_lock(&r->lock);
+    slot->size = n > 0 ? (size_t)n : 0;
+    slot->error = error;
+    slot->full = true;
+    pthread_cond_broadcast(&r->cond);
+    pthread_mutex_unlock(&r->lock);
+    if (n <= 0)
+      return NULL;
+  }
+}
+
+// Makes the next chunk current. False at EOF or on error.
+static bool reader_fill(FileReader *r) {
+  r->chunk = NULL;
+  r->chunk_len = r->pos = 0;
+  if (r->eof || r->error)
+    return false;
+
+  ReaderSlot *slot;
+  if (r->background) {
+    pthread_mutex_lock(&r->lock);
+    r->current = -1; // the previous chunk may be overwritten now
+    pthread_cond_broadcast(&r->cond);
+    slot = &r->slots[r->next];
+    while (!slot->full)
+      pthread_cond_wait(&r->cond, &r->lock);
+    slot->full = false;
+    r->current = r->next;
+    r->next ^= 1;
+    pthread_mutex_unlock(&r->lock);
+  } else {
+    slot = &r->slots[0];
+    ssize_t n = read_full(r->fd, slot->data, r->chunk_size);
+    slot->size = n > 0 ? (size_t)n : 0;
+    slot->error = n < 0 ? errno : 0;
+    if (n > 0) {
+      // Start the kernel on the following chunk while the caller works.
+      off_t offset = lseek(r->fd, 0, SEEK_CUR);
+      if (offset >= 0)
+        posix_fadvise(r->fd, offset, (off_t)r->chunk_size,
+                      POSIX_FADV_WILLNEED);
+    }
+  }
+
+  if (slot->error) {
+    r->error = slot->error;
+    return false;
+  }
+  if (slot->size == 0) {
+    r->eof = true;
+    return false;
+  }
+  r->chunk = slot->data;
+  r->chunk_len = slot->size;
+  return true;
+}
 
-  size_t len = strlen(text);
-  size_t written = fwrite(text, 1, len, f);
-  fclose(f);
+static bool reader_carry(FileReader *r, const char *data, size_t len) {
+  if (r->carry_len + len > r->carry_cap) {
+    size_t cap = r->carry_cap ? r->carry_cap : 256;
+    while (cap < r->carry_len + len)
+      cap *= 2;
+    char *grown = realloc(r->carry, cap);
+    if (!grown) {
+      r->error = ENOMEM;
+      return false;
+    }
+    r->carry = grown;
+    r->carry_cap = cap;
+  }
+  memcpy(r->carry + r->carry_len, data, len);
+  r->carry_len += len;
+  return true;
+}
+
+static bool reader_emit(const char *data, size_t len, const char **line,
+                        size_t *length) {
+  if (len > 0 && data[len - 1] == '\r')
+    len--; // CRLF terminator
+  *line = data;
+  *length = len;
+  return true;
+}
+
+FileReader *file_reader_open(const char *path, FileReaderOptions options) {
+  FileReader *r = calloc(1, sizeof *r);
+  if (!r)
+    return NULL;
+  r->chunk_size = options.chunk_size ? options.chunk_size : 1 << 20;
+  r->background = options.background;
+  r->current = -1;
+
+  r->fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (r->fd < 0) {
+    free(r);
+    return NULL;
+  }
+  posix_fadvise(r->fd, 0, 0, POSIX_FADV_SEQUENTIAL); // fails on pipes
+
+  int error = 0;
+  for (int i = 0; i < (r->background ? 2 : 1); i++)
+    if (!(r->slots[i].data = malloc(r->chunk_size)))
+      error = ENOMEM;
+  if (!error && r->background) {
+    pthread_mutex_init(&r->lock, NULL);
+    pthread_cond_init(&r->cond, NULL);
+    error = pthread_create(&r->thread, NULL, reader_thread, r);
+    if (error) {
+      pthread_cond_destroy(&r->cond);
+      pthread_mutex_destroy(&r->lock);
+      r->background = false;
+    }
+  }
+  if (error) {
+    r->background = false;
+    file_reader_close(r);
+    errno = error;
+    return NULL;
+  }
+  return r;
+}
+
+bool file_reader_next_chunk(FileReader *reader, const char **data,
+                            size_t *size) {
+  if (!reader_fill(reader))
+    return false;
+  *data = reader->chunk;
+  *size = reader->chunk_len;
+  return true;
+}
+
+bool file_reader_next_line(FileReader *reader, const char **line,
+                           size_t *length) {
+  FileReader *r = reader;
+  if (r->carry_returned) {
+    r->carry_len = 0;
+    r->carry_returned = false;
+  }
+
+  for (;;) {
+    const char *start = r->chunk + r->pos;
+    size_t avail = r->chunk_len - r->pos;
+    const char *nl = avail ? memchr(start, '\n', avail) : NULL;
+    if (nl) {
+      size_t len = (size_t)(nl - start);
+      r->pos += len + 1;
+      if (r->carry_len == 0)
+        return reader_emit(start, len, line, length); // no copy
+      if (!reader_carry(r, start, len))
+        return false;
+      r->carry_returned = true;
+      return reader_emit(r->carry, r->carry_len, line, length);
+    }
+
+    // The line continues in the next chunk, which replaces this buffer.
+    if (avail && !reader_carry(r, start, avail))
+      return false;
+    if (!reader_fill(r)) {
+      if (r->error || r->carry_len == 0)
+        return false;
+      r->carry_returned = true; // last line without a trailing newline
+      return reader_emit(r->carry, r->carry_len, line, length);
+    }
+  }
+}
+
+int file_reader_error(const FileReader *reader) { return reader->error; }
+
+void file_reader_close(FileReader *reader) {
+  if (!reader)
+    return;
+  if (reader->background) {
+    pthread_mutex_lock(&reader->lock);
+    reader->stop = true;
+    pthread_cond_broadcast(&reader->cond);
+    pthread_mutex_unlock(&reader->lock);
+    pthread_join(reader->thread, NULL);
+    pthread_cond_destroy(&reader->cond);
+    pthread_mutex_destroy(&reader->lock);
+  }
+  close(reader->fd);
+  free(reader->slots[0].data);
+  free(reader->slots[1].data);
+  free(reader->carry);
+  free(reader);
+}
+
+// ===== Batch loading =====
+
+// Loads one file with blocking calls (the thread pool path).
+static void load_one(FileLoad *file) {
+  file->data = NULL;
+  file->size = 0;
+  int fd = open(file->path, O_RDONLY | O_CLOEXEC);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    file->error = errno;
+    if (fd >= 0)
+      close(fd);
+    return;
+  }
+
+  if (S_ISREG(st.st_mode) && st.st_size > 0) {
+    char *buf = malloc((size_t)st.st_size + 1);
+    ssize_t n = buf ? read_full(fd, buf, (size_t)st.st_size) : -1;
+    if (n < 0) {
+      file->error = buf ? errno : ENOMEM;
+      free(buf);
+    } else {
+      buf[n] = '\0';
+      file->data = buf;
+      file->size = (size_t)n;
+    }
+  } else {
+    FileView view;
+    if (file_read_stream(fd, &view)) {
+      file->data = (char *)view.data;
+      file->size = view.size;
+    } else {
+      file->error = errno ? errno : ENOMEM;
+    }
+  }
+  close(fd);
+  if (file->data)
+    file->error = 0;
+}
+
+typedef struct {
+  FileLoad *files;
+  size_t count;
+  _Atomic size_t next;
+} LoadPool;
+
+static void *load_worker(void *arg) {
+  LoadPool *pool = arg;
+  for (;;) {
+    size_t i = atomic_fetch_add(&pool->next, 1);
+    if (i >= pool->count)
+      return NULL;
+    load_one(&pool->files[i]);
+  }
+}
+
+static void load_with_threads(FileLoad *files, size_t count,
+                              unsigned threads) {
+  LoadPool pool = {.files = files, .count = count};
+  atomic_init(&pool.next, 0);
+  if (threads == 0)
+    threads = 1;
+  if (threads > count)
+    threads = (unsigned)count;
+
+  pthread_t *ids = malloc(threads * sizeof *ids);
+  unsigned started = 0;
+  while (ids && started < threads &&
+         pthread_create(&ids[started], NULL, load_worker, &pool) == 0)
+    started++;
+  load_worker(&pool); // the caller works too, and covers failed spawns
+  for (unsigned i = 0; i < started; i++)
+    pthread_join(ids[i], NULL);
+  free(ids);
+}
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+
+// Minimal io_uring driver over the raw syscalls (no liburing).
+typedef struct {
+  int fd;
+  unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+  unsigned *cq_head, *cq_tail, *cq_mask;
+  struct io_uring_sqe *sqes;
+  struct io_uring_cqe *cqes;
+  void *sq_ring, *cq_ring;
+  size_t sq_ring_size, cq_ring_size, sqes_size;
+  unsigned entries;
+  unsigned pending; // queued but not yet submitted
+  unsigned reaped;  // completions consumed; *sq_head - reaped are in flight
+} Uring;
+
+static void uring_exit(Uring *ring) {
+  if (ring->sqes)
+    munmap(ring->sqes, ring->sqes_size);
+  if (ring->cq_ring && ring->cq_ring != ring->sq_ring)
+    munmap(ring->cq_ring, ring->cq_ring_size);
+  if (ring->sq_ring)
+    munmap(ring->sq_ring, ring->sq_ring_size);
+  close(ring->fd);
+}
+
+static bool uring_supports(int fd, const int *ops, size_t count) {
+  size_t size = sizeof(struct io_uring_probe) +
+                256 * sizeof(struct io_uring_probe_op);
+  struct io_uring_probe *probe = calloc(1, size);
+  if (!probe)
+    return false;
+  bool ok = syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe,
+                    256) == 0;
+  for (size_t i = 0; ok && i < count; i++)
+    ok = ops[i] <= probe->last_op &&
+         (probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED);
+  free(probe);
+  return ok;
+}
+
+static bool uring_init(Uring *ring, unsigned entries) {
+  struct io_uring_params p = {0};
+  *ring = (Uring){0};
+  ring->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+  if (ring->fd < 0)
+    return false; // ENOSYS, or disabled by sysctl/seccomp
+
+  static const int ops[] = {IORING_OP_OPENAT, IORING_OP_STATX,
+                            IORING_OP_READ, IORING_OP_CLOSE};
+  if (!uring_supports(ring->fd, ops, sizeof ops / sizeof *ops)) {
+    close(ring->fd);
+    return false;
+  }
+
+  ring->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  ring->cq_ring_size =
+      p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+  if (single && ring->cq_ring_size > ring->sq_ring_size)
+    ring->sq_ring_size = ring->cq_ring_size;
+
+  ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  if (ring->sq_ring == MAP_FAILED) {
+    ring->sq_ring = NULL;
+    uring_exit(ring);
+    return false;
+  }
+  ring->cq_ring = single ? ring->sq_ring
+                         : mmap(NULL, ring->cq_ring_size,
+                                PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, ring->fd,
+                                IORING_OFF_CQ_RING);
+  ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (ring->cq_ring == MAP_FAILED || ring->sqes == MAP_FAILED) {
+    if (ring->cq_ring == MAP_FAILED)
+      ring->cq_ring = NULL;
+    if (ring->sqes == MAP_FAILED)
+      ring->sqes = NULL;
+    uring_exit(ring);
+    return false;
+  }
+
+  char *sq = ring->sq_ring, *cq = ring->cq_ring;
+  ring->sq_head = (unsigned *)(sq + p.sq_off.head);
+  ring->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+  ring->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+  ring->sq_array = (unsigned *)(sq + p.sq_off.array);
+  ring->cq_head = (unsigned *)(cq + p.cq_off.head);
+  ring->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+  ring->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+  ring->entries = p.sq_entries;
+  return true;
+}
+
+// Callers never queue more than ring->entries operations in flight, so a
+// free SQE is always available.
+static struct io_uring_sqe *uring_sqe(Uring *ring, uint64_t user_data) {
+  unsigned tail = *ring->sq_tail + ring->pending;
+  unsigned index = tail & *ring->sq_mask;
+  struct io_uring_sqe *sqe = &ring->sqes[index];
+  memset(sqe, 0, sizeof *sqe);
+  sqe->user_data = user_data;
+  ring->sq_array[index] = index;
+  ring->pending++;
+  return sqe;
+}
+
+// Submits everything queued and waits for at least one completion.
+static bool uring_submit_and_wait(Uring *ring) {
+  __atomic_store_n(ring->sq_tail, *ring->sq_tail + ring->pending,
+                   __ATOMIC_RELEASE);
+  ring->pending = 0;
+  for (;;) {
+    // Count from the kernel's head: a short or interrupted submit leaves
+    // the rest in the ring for the next call.
+    unsigned submit =
+        *ring->sq_tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    long n = syscall(__NR_io_uring_enter, ring->fd, submit, 1,
+                     IORING_ENTER_GETEVENTS, NULL, 0);
+    if (n >= 0)
+      return true;
+    if (errno != EINTR && errno != EAGAIN)
+      return false;
+  }
+}
+
+enum { OP_OPEN, OP_STATX, OP_READ, OP_CLOSE };
+
+typedef struct {
+  size_t file; // index into the caller's array
+  int fd;
+  int waiting; // completions outstanding for the current step
+  size_t cap;
+  bool sized; // stop reading at stx.stx_size instead of at EOF
+  struct statx stx;
+} LoadSlot;
+
+#define SLOT_DATA(slot, op) ((uint64_t)(slot) << 2 | (op))
+
+static void slot_read(Uring *ring, LoadSlot *slot, FileLoad *file,
+                      size_t index) {
+  struct io_uring_sqe *sqe = uring_sqe(ring, SLOT_DATA(index, OP_READ));
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = slot->fd;
+  sqe->addr = (uint64_t)(uintptr_t)(file->data + file->size);
+  size_t left = slot->cap - 1 - file->size;
+  sqe->len = left < (1u << 30) ? (uint32_t)left : 1u << 30; // sqe->len is u32
+  sqe->off = file->size;
+  slot->waiting = 1;
+}
+
+static void slot_close(Uring *ring, LoadSlot *slot, size_t index) {
+  struct io_uring_sqe *sqe = uring_sqe(ring, SLOT_DATA(index, OP_CLOSE));
+  sqe->opcode = IORING_OP_CLOSE;
+  sqe->fd = slot->fd;
+  slot->fd = -1; // the kernel owns it now
+  slot->waiting = 1;
+}
+
+// Open and statx go out together; the read starts once both are back.
+static void slot_start(Uring *ring, LoadSlot *slot, FileLoad *file,
+                       size_t index) {
+  *file = (FileLoad){.path = file->path};
+  slot->fd = -1;
+
+  struct io_uring_sqe *sqe = uring_sqe(ring, SLOT_DATA(index, OP_OPEN));
+  sqe->opcode = IORING_OP_OPENAT;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = (uint64_t)(uintptr_t)file->path;
+  sqe->open_flags = O_RDONLY | O_CLOEXEC;
+
+  sqe = uring_sqe(ring, SLOT_DATA(index, OP_STATX));
+  sqe->opcode = IORING_OP_STATX;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = (uint64_t)(uintptr_t)file->path;
+  sqe->len = STATX_TYPE | STATX_SIZE;
+  sqe->off = (uint64_t)(uintptr_t)&slot->stx;
+  slot->waiting = 2;
+}
 
-  return (written == len) ? 0 : 2; // 0 success, 2 partial write
+// Advances one file's state machine. Returns true when the file is done.
+static bool slot_complete(Uring *ring, LoadSlot *slot, FileLoad *file,
+                          size_t index, int op, int res) {
+  switch (op) {
+  case OP_OPEN:
+  case OP_STATX:
+    if (op == OP_OPEN && res >= 0)
+      slot->fd = res;
+    else if (res < 0 && !file->error)
+      file->error = -res;
+    if (--slot->waiting > 0)
+      return false;
+    if (file->error) {
+      if (slot->fd < 0)
+        return true;
+      slot_close(ring, slot, index);
+      return false;
+    }
+    slot->sized = S_ISREG(slot->stx.stx_mode) && slot->stx.stx_size > 0;
+    slot->cap = slot->sized ? slot->stx.stx_size + 1 : 4096;
+    if (!(file->data = malloc(slot->cap))) {
+      file->error = ENOMEM;
+      slot_close(ring, slot, index);
+      return false;
+    }
+    slot_read(ring, slot, file, index);
+    return false;
+
+  case OP_READ:
+    if (res == -EINTR || res == -EAGAIN) {
+      slot_read(ring, slot, file, index);
+      return false;
+    }
+    if (res < 0) {
+      file->error = -res;
+    } else if (res > 0) {
+      file->size += (size_t)res;
+      if (!slot->sized || file->size < slot->stx.stx_size) {
+        if (file->size + 1 == slot->cap) { // unknown size: keep growing
+          char *grown = realloc(file->data, slot->cap * 2);
+          if (!grown) {
+            file->error = ENOMEM;
+            slot_close(ring, slot, index);
+            return false;
+          }
+          file->data = grown;
+          slot->cap *= 2;
+        }
+        slot_read(ring, slot, file, index);
+        return false;
+      }
+    }
+    slot_close(ring, slot, index);
+    return false;
+
+  default: // OP_CLOSE
+    if (file->error) {
+      free(file->data);
+      file->data = NULL;
+      file->size = 0;
+    } else {
+      file->data[file->size] = '\0';
+    }
+    return true;
+  }
+}
+
+// After a failed submit, makes it safe to free the buffers: closes the fds
+// of CLOSE operations the kernel never took, then waits for every operation
+// it did take. Fds from opens that complete meanwhile go to their slot. False
+// if waiting failed too, in which case a READ may still be writing into its
+// buffer, and the caller must leak it rather than free it.
+static bool uring_drain(Uring *ring, LoadSlot *slots) {
+  unsigned end = *ring->sq_tail + ring->pending;
+  for (unsigned i = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE); i != end;
+       i++) {
+    struct io_uring_sqe *sqe = &ring->sqes[i & *ring->sq_mask];
+    if (sqe->opcode == IORING_OP_CLOSE)
+      close(sqe->fd);
+  }
+  ring->pending = 0;
+
+  while (__atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) != ring->reaped) {
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      long n = syscall(__NR_io_uring_enter, ring->fd, 0, 1,
+                       IORING_ENTER_GETEVENTS, NULL, 0);
+      if (n < 0 && errno != EINTR)
+        return false;
+      continue;
+    }
+    for (; head != tail; head++, ring->reaped++) {
+      struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+      if ((cqe->user_data & 3) == OP_OPEN && cqe->res >= 0)
+        slots[cqe->user_data >> 2].fd = cqe->res;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+  }
+  return true;
+}
+
+// Returns how many files from the front of the array it dealt with; the
+// caller loads the rest another way.
+static size_t load_with_uring(FileLoad *files, size_t count, unsigned depth) {
+  Uring ring;
+  if (!uring_init(&ring, depth ? depth : 64))
+    return 0;
+
+  // Each file has at most two operations in flight.
+  size_t nslots = ring.entries / 2 ? ring.entries / 2 : 1;
+  if (nslots > count)
+    nslots = count;
+  LoadSlot *slots = malloc(nslots * sizeof *slots);
+  if (!slots) {
+    uring_exit(&ring);
+    return 0;
+  }
+
+  size_t next = 0, active = 0;
+  for (; next < nslots; next++, active++) {
+    slots[next].file = next;
+    slot_start(&ring, &slots[next], &files[next], next);
+  }
+
+  int error = 0;
+  while (active > 0) {
+    if (!uring_submit_and_wait(&ring)) {
+      error = errno;
+      break;
+    }
+
+    unsigned head = *ring.cq_head;
+    unsigned tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++, ring.reaped++) {
+      struct io_uring_cqe *cqe = &ring.cqes[head & *ring.cq_mask];
+      size_t index = (size_t)(cqe->user_data >> 2);
+      int op = (int)(cqe->user_data & 3);
+      LoadSlot *slot = &slots[index];
+      if (!slot_complete(&ring, slot, &files[slot->file], index, op,
+                         cqe->res))
+        continue;
+      slot->waiting = 0;
+      if (next < count) {
+        slot->file = next++;
+        slot_start(&ring, slot, &files[slot->file], index);
+      } else {
+        active--;
+      }
+    }
+    __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+  }
+
+  // Closing the ring does not wait for operations still in flight.
+  bool drained = !error || uring_drain(&ring, slots);
+  uring_exit(&ring);
+  if (error) {
+    for (size_t i = 0; i < nslots; i++) {
+      if (slots[i].waiting == 0)
+        continue;
+      FileLoad *file = &files[slots[i].file];
+      if (drained)
+        free(file->data);
+      *file = (FileLoad){.path = file->path, .error = error};
+      if (slots[i].fd >= 0)
+        close(slots[i].fd);
+    }
+  }
+  if (drained) // a STATX may still write into its slot otherwise
+    free(slots);
+  return next;
+}
+
+#else
+
+static size_t load_with_uring(FileLoad *files, size_t count, unsigned depth) {
+  (void)files, (void)count, (void)depth;
+  return 0;
+}
+
+#endif
+
+size_t file_load_batch(FileLoad *files, size_t count,
+                       FileBatchOptions options) {
+  size_t done =
+      options.use_uring ? load_with_uring(files, count, options.queue_depth)
+                        : 0;
+  if (done < count)
+    load_with_threads(files + done, count - done, options.threads);
+
+  size_t loaded = 0;
+  for (size_t i = 0; i < count; i++)
+    loaded += files[i].data != NULL;
+  return loaded;
+}
+
+void file_load_free(FileLoad *files, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    free(files[i].data);
+    files[i].data = NULL;
+    files[i].size = 0;
+  }
+}
+
+// ===== Writing =====
+
+// Writes every iovec, resuming after short writes. Modifies iov.
+static bool write_all_v(int fd, struct iovec *iov, int count) {
+  while (count > 0) {
+    ssize_t n = writev(fd, iov, count);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    size_t done = (size_t)n;
+    while (count > 0 && done >= iov->iov_len) {
+      done -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if (count > 0) {
+      iov->iov_base = (char *)iov->iov_base + done;
+      iov->iov_len -= done;
+    }
+  }
+  return true;
+}
+
+// Persists a rename: the new directory entry must reach the disk too.
+static void sync_parent_dir(const char *path) {
+  const char *slash = strrchr(path, '/');
+  char dir[4096];
+  if (!slash)
+    strcpy(dir, ".");
+  else if (slash == path)
+    strcpy(dir, "/");
+  else if ((size_t)(slash - path) < sizeof dir)
+    snprintf(dir, sizeof dir, "%.*s", (int)(slash - path), path);
+  else
+    return;
+  int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+}
+
+bool write_file(const char *filename, const char *content) {
+  // The temp file must live in the target's directory for rename to be
+  // atomic; it is hidden so globbing tools skip it.
+  const char *slash = strrchr(filename, '/');
+  const char *base = slash ? slash + 1 : filename;
+  int dir_len = slash ? (int)(base - filename) : 0;
+  char tmp[4096];
+  if (snprintf(tmp, sizeof tmp, "%.*s.%s.XXXXXX", dir_len, filename, base) >=
+      (int)sizeof tmp) {
+    errno = ENAMETOOLONG;
+    return false;
+  }
+
+  int fd = mkstemp(tmp);
+  if (fd < 0)
+    return false;
+
+  // mkstemp creates 0600; keep the mode of the file being replaced.
+  struct stat st;
+  fchmod(fd, stat(filename, &st) == 0 ? st.st_mode & 07777 : 0644);
+
+  struct iovec iov = {.iov_base = (void *)content, .iov_len = strlen(content)};
+  bool ok = write_all_v(fd, &iov, 1) && fsync(fd) == 0;
+  int saved = errno;
+  if (close(fd) != 0 && ok) {
+    ok = false;
+    saved = errno;
+  }
+  if (ok && rename(tmp, filename) != 0) {
+    ok = false;
+    saved = errno;
+  }
+  if (!ok) {
+    unlink(tmp);
+    errno = saved;
+    return false;
+  }
+  sync_parent_dir(filename);
+  return true;
+}
+
+bool append_file(const char *filename, const char *content) {
+  int fd = open(filename, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0)
+    return false;
+  struct iovec iov = {.iov_base = (void *)content, .iov_len = strlen(content)};
+  bool ok = write_all_v(fd, &iov, 1);
+  int saved = errno;
+  close(fd);
+  errno = saved;
+  return ok;
+}
+
+struct FileWriter {
+  int fd;
+  char *buffer;
+  size_t used;
+  size_t capacity;
+};
+
+FileWriter *file_writer_open(const char *path, size_t buffer_size) {
+  FileWriter *w = malloc(sizeof *w);
+  if (!w)
+    return NULL;
+  w->capacity = buffer_size ? buffer_size : 64 * 1024;
+  w->used = 0;
+  w->buffer = malloc(w->capacity);
+  w->fd = open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+  if (!w->buffer || w->fd < 0) {
+    int saved = w->buffer ? errno : ENOMEM;
+    if (w->fd >= 0)
+      close(w->fd);
+    free(w->buffer);
+    free(w);
+    errno = saved;
+    return NULL;
+  }
+  return w;
+}
+
+bool file_writer_write(FileWriter *writer, const void *data, size_t size) {
+  if (writer->used + size <= writer->capacity) {
+    memcpy(writer->buffer + writer->used, data, size);
+    writer->used += size;
+    return true;
+  }
+
+  // Too big to coalesce: send the pending bytes and this write together.
+  struct iovec iov[2] = {
+      {.iov_base = writer->buffer, .iov_len = writer->used},
+      {.iov_base = (void *)data, .iov_len = size},
+  };
+  bool ok = writer->used ? write_all_v(writer->fd, iov, 2)
+                         : write_all_v(writer->fd, iov + 1, 1);
+  writer->used = 0;
+  return ok;
+}
+
+bool file_writer_puts(FileWriter *writer, const char *text) {
+  return file_writer_write(writer, text, strlen(text));
+}
+
+bool file_writer_flush(FileWriter *writer) {
+  if (writer->used == 0)
+    return true;
+  struct iovec iov = {.iov_base = writer->buffer, .iov_len = writer->used};
+  writer->used = 0;
+  return write_all_v(writer->fd, &iov, 1);
+}
+
+bool file_writer_sync(FileWriter *writer) {
+  return file_writer_flush(writer) && fdatasync(writer->fd) == 0;
+}
+
+bool file_writer_close(FileWriter *writer) {
+  if (!writer)
+    return true;
+  bool ok = file_writer_flush(writer);
+  int saved = errno;
+  if (close(writer->fd) != 0 && ok) {
+    ok = false;
+    saved = errno;
+  }
+  free(writer->buffer);
+  free(writer);
+  errno = saved;
+  return ok;
+}
+
+int file_write_text(const char *path, const char *text) {
+  return write_file(path, text) ? 0 : 1; // 0 success, 1 error
 }
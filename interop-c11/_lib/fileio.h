@@ -0,0 +1,208 @@
+// fileio.h
+#ifndef FILEIO_H
+#define FILEIO_H
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Failure kinds. Messages are only rendered on request (file_error_name,
+// result_format_error), so neither success nor failure allocates.
+typedef enum {
+  FILE_OK = 0,
+  FILE_ERR_NOT_FOUND,
+  FILE_ERR_PERMISSION,
+  FILE_ERR_IS_DIRECTORY,
+  FILE_ERR_NO_SPACE,  // caller's buffer or arena is too small
+  FILE_ERR_NO_MEMORY, // heap allocation failed
+  FILE_ERR_ENCODING,  // invalid input or unknown ReadOptions.encoding
+  FILE_ERR_IO,        // anything else; see sys_errno
+} FileError;
+
+// Result type inspired by Kotlin's Result<T>
+typedef struct {
+  void *value;
+  size_t size; // bytes at value, where that applies
+  FileError error;
+  int sys_errno; // errno behind the failure, 0 if none
+  bool is_success;
+} Result;
+
+// File operations result
+typedef Result FileResult;
+
+// File reading options. Text always comes back as UTF-8: "UTF-8" input is
+// validated (a BOM is dropped), "LATIN-1" and "UTF-16" (BOM, else LE),
+// "UTF-16LE" and "UTF-16BE" are transcoded, and "BINARY" or NULL skips
+// all checks. Invalid UTF-8 fails with FILE_ERR_ENCODING unless
+// repair_utf8 replaces it with U+FFFD.
+typedef struct {
+  bool trim_whitespace;
+  bool ignore_empty_lines;
+  bool repair_utf8;
+  char *encoding;
+} ReadOptions;
+
+// Default read options
+#define DEFAULT_READ_OPTIONS                                                   \
+  {.trim_whitespace = false,                                                   \
+   .ignore_empty_lines = false,                                                \
+   .repair_utf8 = false,                                                       \
+   .encoding = "UTF-8"}
+
+// Read-only view of a file's bytes. Regular files are mmap'd (no copy);
+// pipes, procfs/sysfs files and other streams are read into a heap buffer.
+typedef struct {
+  const char *data;
+  size_t size;
+  bool mapped; // false: data is a NUL-terminated heap copy
+} FileView;
+
+// One line of a LineIndex: a span into the view, without the '\n'.
+typedef struct {
+  size_t offset;
+  size_t length;
+} LineSpan;
+
+// Value of a successful read_lines(). Lines are not copied or
+// NUL-terminated; they point into the file view and live until
+// free_lines().
+typedef struct {
+  FileView view;
+  LineSpan *lines;
+  size_t count;
+} LineIndex;
+
+#define LINE_AT(index, i) ((index)->view.data + (index)->lines[i].offset)
+
+// Streaming reader for files that should not be loaded whole. Memory stays
+// at one chunk (two with a background reader) plus the longest line that
+// straddles a chunk boundary.
+typedef struct FileReader FileReader;
+
+typedef struct {
+  size_t chunk_size;
+  bool background; // read the next chunk on a thread while this one is used
+} FileReaderOptions;
+
+#define DEFAULT_FILE_READER_OPTIONS {.chunk_size = 1 << 20, .background = false}
+
+// Bump allocator over caller memory for allocation-free reads. Values read
+// into an arena live until the caller resets or reuses the buffer.
+typedef struct {
+  char *base;
+  size_t size;
+  size_t used;
+} FileArena;
+
+#define FILE_ARENA(buffer, bytes)                                              \
+  ((FileArena){.base = (char *)(buffer), .size = (bytes), .used = 0})
+
+// Buffered appender: small writes are coalesced and reach the file in one
+// writev when the buffer fills, on flush and on close. Not thread-safe.
+typedef struct FileWriter FileWriter;
+
+// One entry of a batch load. Fill in path; the loader sets the rest.
+typedef struct {
+  const char *path;
+  char *data; // NUL-terminated heap buffer, NULL on error
+  size_t size;
+  int error; // errno value, 0 on success
+} FileLoad;
+
+typedef struct {
+  unsigned queue_depth; // io_uring entries in flight
+  unsigned threads;     // fallback pool size
+  bool use_uring;
+} FileBatchOptions;
+
+#define DEFAULT_FILE_BATCH_OPTIONS                                             \
+  {.queue_depth = 64, .threads = 8, .use_uring = true}
+
+// Function prototypes
+char *file_read_text(const char *path);
+int file_write_text(const char *path, const char *text);
+
+bool file_map(const char *path, FileView *view); // false with errno set
+void file_unmap(FileView *view);
+
+// read_file results own a heap buffer (release with free_result);
+// read_file_into places the NUL-terminated content in the arena instead.
+FileResult read_file(const char *filename);
+FileResult read_file_with_options(const char *filename, ReadOptions options);
+FileResult read_file_into(const char *filename, FileArena *arena);
+FileResult read_lines(const char *filename);
+FileResult read_lines_with_options(const char *filename, ReadOptions options);
+void free_lines(LineIndex *index);
+
+// Use either next_chunk or next_line on a reader, not both. Returned data
+// stays valid until the next call; false means end of file, or an error
+// when file_reader_error() is non-zero.
+FileReader *file_reader_open(const char *path, FileReaderOptions options);
+bool file_reader_next_chunk(FileReader *reader, const char **data,
+                            size_t *size);
+bool file_reader_next_line(FileReader *reader, const char **line,
+                           size_t *length); // without the line terminator
+int file_reader_error(const FileReader *reader); // errno value, 0 at EOF
+void file_reader_close(FileReader *reader);
+
+// Loads many files with overlapped I/O: one io_uring on Linux 5.6+, a
+// thread pool elsewhere. Returns how many loaded; see FileLoad.error.
+size_t file_load_batch(FileLoad *files, size_t count, FileBatchOptions options);
+void file_load_free(FileLoad *files, size_t count);
+
+// write_file replaces the file atomically: readers see the old or the new
+// content, never a torn mix, even if the process or machine dies mid-write.
+bool write_file(const char *filename, const char *content);
+bool append_file(const char *filename, const char *content);
+
+FileWriter *file_writer_open(const char *path, size_t buffer_size);
+bool file_writer_write(FileWriter *writer, const void *data, size_t size);
+bool file_writer_puts(FileWriter *writer, const char *text);
+bool file_writer_flush(FileWriter *writer);
+bool file_writer_sync(FileWriter *writer); // flush + fdatasync
+bool file_writer_close(FileWriter *writer); // false if the final flush failed
+
+bool file_exists(const char *filename);
+bool is_directory(const char *path);
+long file_size(const char *filename);
+
+bool utf8_validate(const char *data, size_t size);
+// Copy with each invalid byte replaced by U+FFFD; heap, NUL-terminated.
+char *utf8_repair(const char *data, size_t size, size_t *out_size);
+
+void *arena_alloc(FileArena *arena, size_t size); // NULL when full
+void arena_reset(FileArena *arena);
+
+FileError file_error_from_errno(int err);
+const char *file_error_name(FileError error); // static string
+// snprintf-style: writes at most size bytes, returns the full length.
+size_t result_format_error(Result result, char *buf, size_t size);
+
+void free_result(Result result);     // frees a heap value (read_file)
+char *result_to_string(Result result); // heap copy, for debugging
+
+// Utility macros for cleaner usage
+#define SUCCESS(val)                                                           \
+  ((Result){.value = (val), .error = FILE_OK, .is_success = true})
+#define FAILURE(code)                                                          \
+  ((Result){.value = NULL, .error = (code), .is_success = false})
+#define FAILURE_ERRNO(err)                                                     \
+  ((Result){.value = NULL,                                                     \
+            .error = file_error_from_errno(err),                               \
+            .sys_errno = (err),                                                \
+            .is_success = false})
+
+#define RESULT_GET(value_type, result) ((value_type)(result).value)
+#define RESULT_ON_SUCCESS(result, block)                                       \
+  if ((result).is_success) {                                                   \
+    block;                                                                     \
+  }
+#define RESULT_ON_FAILURE(result, block)                                       \
+  if (!(result).is_success) {                                                  \
+    block;                                                                     \
+  }
+
+#endif
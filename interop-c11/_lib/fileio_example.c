@@ -11,6 +11,36 @@ int main() {
     printf("Failed to read file.\n");
   }
 
+  char storage[64 * 1024];
+  FileArena arena = FILE_ARENA(storage, sizeof storage);
+  FileResult result = read_file_into("input.txt", &arena);
+  RESULT_ON_FAILURE(result, {
+    char message[128];
+    result_format_error(result, message, sizeof message);
+    printf("read_file_into: %s\n", message);
+  });
+  RESULT_ON_SUCCESS(result, printf("Read %zu bytes into the arena\n",
+                                   result.size));
+
+  FileView view;
+  if (file_map("/proc/self/status", &view)) {
+    printf("Mapped %zu bytes (%s)\n", view.size,
+           view.mapped ? "mmap" : "read fallback");
+    file_unmap(&view);
+  }
+
+  FileReader *reader = file_reader_open(
+      "input.txt", (FileReaderOptions){.chunk_size = 64 * 1024,
+                                       .background = true});
+  if (reader) {
+    const char *line;
+    size_t length, count = 0;
+    while (file_reader_next_line(reader, &line, &length))
+      count++;
+    printf("Streamed %zu lines\n", count);
+    file_reader_close(reader);
+  }
+
   if (file_write_text("output.txt", "Hello Kotlin-inspired C11!") == 0) {
     printf("File written successfully.\n");
   } else {
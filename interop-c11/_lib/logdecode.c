@@ -0,0 +1,210 @@
+// logdecode.c — Reconstructs text from a binary log written by logger.c
+// cc -std=c11 logdecode.c logger.c -o logdecode && ./logdecode app.bin
+#define _GNU_SOURCE
+#include "logger.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+  char *fmt;
+  int nargs;
+  uint8_t kinds[LOG_MAX_ARGS];
+} DecodedFormat;
+
+typedef struct {
+  const char *p;
+  const char *end;
+} Payload;
+
+static int take(Payload *in, void *out, size_t size) {
+  if ((size_t)(in->end - in->p) < size)
+    return 0;
+  memcpy(out, in->p, size);
+  in->p += size;
+  return 1;
+}
+
+// Prints one conversion (spec is "%...c" with '*' already substituted).
+static void print_arg(FILE *out, const char *spec, uint8_t kind, Payload *in) {
+  int64_t v = 0;
+  switch (kind) {
+  case LOG_ARG_INT: {
+    int x;
+    if (take(in, &x, sizeof(x)))
+      fprintf(out, spec, x);
+    return;
+  }
+  case LOG_ARG_DOUBLE:
+  case LOG_ARG_LDOUBLE: {
+    double d;
+    if (!take(in, &d, sizeof(d)))
+      return;
+    if (kind == LOG_ARG_DOUBLE)
+      fprintf(out, spec, d);
+    else
+      fprintf(out, spec, (long double)d);
+    return;
+  }
+  case LOG_ARG_STRING: {
+    uint16_t n;
+    if (!take(in, &n, sizeof(n)) || (size_t)(in->end - in->p) < n)
+      return;
+    char *s = strndup(in->p, n);
+    in->p += n;
+    fprintf(out, spec, s);
+    free(s);
+    return;
+  }
+  }
+  if (!take(in, &v, sizeof(v)))
+    return;
+  switch (kind) {
+  case LOG_ARG_LONG:
+    fprintf(out, spec, (long)v);
+    break;
+  case LOG_ARG_LLONG:
+    fprintf(out, spec, (long long)v);
+    break;
+  case LOG_ARG_SIZE:
+    fprintf(out, spec, (size_t)v);
+    break;
+  case LOG_ARG_INTMAX:
+    fprintf(out, spec, (intmax_t)v);
+    break;
+  case LOG_ARG_PTRDIFF:
+    fprintf(out, spec, (ptrdiff_t)v);
+    break;
+  case LOG_ARG_POINTER:
+    fprintf(out, spec, (void *)(uintptr_t)v);
+    break;
+  }
+}
+
+// Walks fmt the same way log_format_arg_kinds does, consuming payload args.
+static void print_message(FILE *out, const DecodedFormat *f, Payload *in) {
+  int arg = 0;
+  for (const char *p = f->fmt; *p;) {
+    if (*p != '%') {
+      const char *q = strchr(p, '%');
+      size_t n = q ? (size_t)(q - p) : strlen(p);
+      fwrite(p, 1, n, out);
+      p += n;
+      continue;
+    }
+    if (p[1] == '%') {
+      fputc('%', out);
+      p += 2;
+      continue;
+    }
+
+    char spec[64];
+    size_t len = 0;
+    spec[len++] = *p++;
+    for (; *p && len < sizeof(spec) - 16; p++) {
+      if (*p == '*') {
+        int x = 0;
+        if (arg < f->nargs)
+          arg++;
+        take(in, &x, sizeof(x));
+        len += snprintf(spec + len, sizeof(spec) - len, "%d", x);
+        continue;
+      }
+      spec[len++] = *p;
+      if (strchr("diuoxXcfFeEgGaAsp", *p)) {
+        p++;
+        break;
+      }
+    }
+    spec[len] = '\0';
+    if (arg < f->nargs)
+      print_arg(out, spec, f->kinds[arg++], in);
+  }
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <file.bin> [output.txt]\n", argv[0]);
+    return 1;
+  }
+  FILE *in = fopen(argv[1], "rb");
+  if (!in) {
+    perror(argv[1]);
+    return 1;
+  }
+  FILE *out = argc > 2 ? fopen(argv[2], "w") : stdout;
+  if (!out) {
+    perror(argv[2]);
+    return 1;
+  }
+
+  char magic[LOG_BIN_MAGIC_LEN];
+  if (fread(magic, 1, sizeof(magic), in) != sizeof(magic) ||
+      memcmp(magic, LOG_BIN_MAGIC, LOG_BIN_MAGIC_LEN) != 0) {
+    fprintf(stderr, "%s: not a binary log\n", argv[1]);
+    return 1;
+  }
+
+  static DecodedFormat formats[LOG_MAX_FORMATS];
+  char *payload = NULL;
+  size_t payload_cap = 0;
+  size_t records = 0;
+  int status = 0;
+  LogBinRecord rec;
+  while (fread(&rec, sizeof(rec), 1, in) == 1) {
+    if (rec.size > payload_cap) {
+      char *grown = realloc(payload, rec.size);
+      if (!grown) {
+        fprintf(stderr, "%s: out of memory for a %lu-byte record\n", argv[1],
+                (unsigned long)rec.size);
+        status = 1;
+        break;
+      }
+      payload = grown;
+      payload_cap = rec.size;
+    }
+    if (fread(payload, 1, rec.size, in) != rec.size) {
+      fprintf(stderr, "%s: truncated record\n", argv[1]);
+      break;
+    }
+    if (rec.id >= LOG_MAX_FORMATS)
+      continue;
+    DecodedFormat *f = &formats[rec.id];
+
+    if (rec.type == LOG_REC_FORMAT) {
+      free(f->fmt);
+      f->fmt = strndup(payload, rec.size);
+      if (!f->fmt) {
+        fprintf(stderr, "%s: out of memory\n", argv[1]);
+        status = 1;
+        break;
+      }
+      f->nargs = log_format_arg_kinds(f->fmt, f->kinds, LOG_MAX_ARGS);
+      continue;
+    }
+    if (rec.type != LOG_REC_MESSAGE || !f->fmt)
+      continue;
+
+    time_t sec = (time_t)(rec.time_ns / 1000000000ull);
+    struct tm t;
+    char stamp[32];
+    localtime_r(&sec, &t);
+    strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &t);
+    fprintf(out, "%s.%06lu [%s] ", stamp,
+            (unsigned long)(rec.time_ns % 1000000000ull / 1000),
+            log_level_name(rec.level));
+    Payload args = {payload, payload + rec.size};
+    print_message(out, f, &args);
+    fputc('\n', out);
+    records++;
+  }
+
+  fprintf(stderr, "Decoded %zu messages\n", records);
+  free(payload);
+  fclose(in);
+  if (out != stdout)
+    fclose(out);
+  return status;
+}
@@ -1,83 +1,609 @@
 // logger.c — General Logger Utility in C11
+// cc -std=c11 -pthread -DLOGGER_MAIN logger.c -o logger
+#define _GNU_SOURCE
+#include "logger.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <spawn.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
 #include <time.h>
-
-// ===== Log Levels =====
-typedef enum { LOG_DEBUG, LOG_INFO, LOG_WARN, LOG_ERROR } LogLevel;
+#include <unistd.h>
 
 static const char *LOG_LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
 
-// ===== Logger Interface =====
-typedef struct Logger {
-  void (*log)(struct Logger *self, LogLevel level, const char *fmt,
-              va_list args);
-  void (*close)(struct Logger *self);
-  void *impl; // implementation-specific data
-} Logger;
+const char *log_level_name(LogLevel level) {
+  return (unsigned)level <= LOG_ERROR ? LOG_LEVEL_NAMES[level] : "?";
+}
+
+// ===== Timestamps =====
+#ifdef CLOCK_REALTIME_COARSE
+#define LOG_CLOCK_COARSE CLOCK_REALTIME_COARSE
+#else
+#define LOG_CLOCK_COARSE CLOCK_REALTIME
+#endif
+
+#define LOG_TIME_MAX 64
+
+// Set from any thread while others log; read relaxed, like the level.
+static _Atomic LogTimeFormat TIME_FORMAT = LOG_TIME_HMS;
+static _Atomic LogTimePrecision TIME_PRECISION = LOG_TIME_SEC;
+
+// Rendered prefix for the last second seen; localtime_r only runs when the
+// second changes (or the format does). Per thread, so it needs no lock.
+static _Thread_local struct {
+  time_t sec;
+  LogTimeFormat format;
+  size_t len;
+  char text[LOG_TIME_MAX];
+} time_cache = {.sec = -1};
+
+void log_set_time_format(LogTimeFormat format, LogTimePrecision precision) {
+  atomic_store_explicit(&TIME_FORMAT, format, memory_order_relaxed);
+  atomic_store_explicit(&TIME_PRECISION, precision, memory_order_relaxed);
+}
+
+// Writes the timestamp into buf (at least LOG_TIME_MAX bytes), returns length.
+static size_t log_format_time(char *buf) {
+  LogTimeFormat format =
+      atomic_load_explicit(&TIME_FORMAT, memory_order_relaxed);
+  LogTimePrecision precision =
+      atomic_load_explicit(&TIME_PRECISION, memory_order_relaxed);
+  struct timespec ts;
+  clock_gettime(precision == LOG_TIME_SEC ? LOG_CLOCK_COARSE : CLOCK_REALTIME,
+                &ts);
+
+  if (ts.tv_sec != time_cache.sec || format != time_cache.format) {
+    struct tm t;
+    localtime_r(&ts.tv_sec, &t);
+    time_cache.len =
+        format == LOG_TIME_ISO8601
+            ? strftime(time_cache.text, LOG_TIME_MAX, "%Y-%m-%dT%H:%M:%S", &t)
+            : strftime(time_cache.text, LOG_TIME_MAX, "%H:%M:%S", &t);
+    time_cache.sec = ts.tv_sec;
+    time_cache.format = format;
+  }
+
+  memcpy(buf, time_cache.text, time_cache.len);
+  size_t len = time_cache.len;
+  switch (precision) {
+  case LOG_TIME_SEC:
+    buf[len] = '\0';
+    break;
+  case LOG_TIME_USEC:
+    len += snprintf(buf + len, LOG_TIME_MAX - len, ".%06ld", ts.tv_nsec / 1000);
+    break;
+  case LOG_TIME_NSEC:
+    len += snprintf(buf + len, LOG_TIME_MAX - len, ".%09ld", ts.tv_nsec);
+    break;
+  case LOG_TIME_MONO: {
+    struct timespec mono;
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    len += snprintf(buf + len, LOG_TIME_MAX - len, " +%lld.%09ld",
+                    (long long)mono.tv_sec, mono.tv_nsec);
+    break;
+  }
+  }
+  return len;
+}
+
+// ===== Line Rendering =====
+#define LOG_LINE_MAX 4096
+
+// Per-thread scratch, so formatting never happens under a target's lock.
+static _Thread_local char LINE_BUF[LOG_LINE_MAX];
+
+// Renders "<time> [LEVEL] message\n" into the thread's scratch buffer. Longer
+// lines go to a heap buffer returned in *heap, which the caller frees.
+static char *log_render_line(LogLevel level, const char *fmt, va_list args,
+                             size_t *len, char **heap) {
+  size_t prefix_len = log_format_time(LINE_BUF);
+  prefix_len += snprintf(LINE_BUF + prefix_len, LOG_LINE_MAX - prefix_len,
+                         " [%s] ", LOG_LEVEL_NAMES[level]);
+  *heap = NULL;
+
+  va_list copy;
+  va_copy(copy, args);
+  int n =
+      vsnprintf(LINE_BUF + prefix_len, LOG_LINE_MAX - prefix_len, fmt, copy);
+  va_end(copy);
+  if (n < 0)
+    n = 0;
+  if (prefix_len + n + 1 < LOG_LINE_MAX) {
+    LINE_BUF[prefix_len + n] = '\n';
+    *len = prefix_len + n + 1;
+    return LINE_BUF;
+  }
+
+  char *line = malloc(prefix_len + n + 2);
+  if (!line) { // keep the truncated line rather than drop it
+    LINE_BUF[LOG_LINE_MAX - 1] = '\n';
+    *len = LOG_LINE_MAX;
+    return LINE_BUF;
+  }
+  memcpy(line, LINE_BUF, prefix_len);
+  vsnprintf(line + prefix_len, n + 1, fmt, args);
+  line[prefix_len + n] = '\n';
+  *len = prefix_len + n + 1;
+  *heap = line;
+  return line;
+}
 
 // ===== Console Logger =====
 typedef struct {
   FILE *stream;
 } ConsoleLoggerImpl;
 
+// A line is one fwrite, which stdio locks, so concurrent lines never
+// interleave.
+static void console_write(Logger *self, LogLevel level, const char *line,
+                          size_t len) {
+  ConsoleLoggerImpl *impl = self->impl;
+  (void)level;
+  fwrite(line, 1, len, impl->stream);
+}
+
 static void console_log(Logger *self, LogLevel level, const char *fmt,
                         va_list args) {
-  ConsoleLoggerImpl *impl = self->impl;
-  time_t now = time(NULL);
-  struct tm *t = localtime(&now);
-  fprintf(impl->stream, "%02d:%02d:%02d [%s] ", t->tm_hour, t->tm_min,
-          t->tm_sec, LOG_LEVEL_NAMES[level]);
-  vfprintf(impl->stream, fmt, args);
-  fprintf(impl->stream, "\n");
+  size_t len;
+  char *heap;
+  char *line = log_render_line(level, fmt, args, &len, &heap);
+  console_write(self, level, line, len);
+  free(heap);
 }
 
-static void console_close(Logger *self) {
-  (void)self; // nothing to free
+static void console_close(Logger *self) { free(self->impl); }
+
+// The make_* constructors exit on failure; the *_open helpers return false
+// with errno set instead, for the C ABI, where exiting would take down the
+// host process.
+static bool console_open(Logger *out, FILE *stream) {
+  ConsoleLoggerImpl *impl = malloc(sizeof(*impl));
+  if (!impl)
+    return false;
+  impl->stream = stream;
+  *out = (Logger){console_log, console_write, console_close, impl};
+  return true;
 }
 
 Logger make_console_logger(FILE *stream) {
-  static ConsoleLoggerImpl impl;
-  impl.stream = stream;
-  Logger logger = {console_log, console_close, &impl};
+  Logger logger;
+  if (!console_open(&logger, stream)) {
+    perror("Failed to create console logger");
+    exit(EXIT_FAILURE);
+  }
   return logger;
 }
 
 // ===== File Logger =====
+// Lines accumulate in a user-space buffer and reach the file in batches; see
+// FileLoggerOptions for when a batch is written and when the file rotates.
+#define LOG_ROTATE_QUEUE 8
+
+typedef struct {
+  int fd;
+  unsigned seq;
+} ClosedSegment;
+
 typedef struct {
-  FILE *fp;
+  int fd;
+  FileLoggerOptions options;
+  char *buf;
+  size_t len;
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_t flusher;
+  bool has_flusher;
+  bool closing;
+
+  // Rotation: the active file is always `path`; closed segments become
+  // path.1, path.2, ... and the next file is prepared as path.next.
+  char *path;
+  char *next_path;
+  size_t file_bytes;
+  time_t opened_at; // CLOCK_MONOTONIC seconds
+  unsigned seq;     // last segment number in use
+  int next_fd;      // preallocated by the rotator, -1 until ready
+  unsigned retired; // segments up to this one are compressed and pruned
+  ClosedSegment closed[LOG_ROTATE_QUEUE]; // fds the rotator still closes
+  size_t closed_count;
+  pthread_cond_t rotate_wake;
+  pthread_t rotator;
+  bool has_rotator;
 } FileLoggerImpl;
 
+extern char **environ;
+
+static time_t file_monotonic_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec;
+}
+
+// Highest N among existing path.N / path.N.gz segments.
+static unsigned file_last_segment(const char *path) {
+  const char *slash = strrchr(path, '/');
+  const char *base = slash ? slash + 1 : path;
+  size_t base_len = strlen(base);
+  char dir[PATH_MAX];
+  snprintf(dir, sizeof(dir), "%.*s", slash ? (int)(slash - path) : 1,
+           slash ? path : ".");
+
+  unsigned last = 0;
+  DIR *d = opendir(dir);
+  if (!d)
+    return 0;
+  for (struct dirent *e; (e = readdir(d));) {
+    if (strncmp(e->d_name, base, base_len) != 0 || e->d_name[base_len] != '.')
+      continue;
+    char *end;
+    unsigned long n = strtoul(e->d_name + base_len + 1, &end, 10);
+    bool numbered = end != e->d_name + base_len + 1;
+    if (numbered && (*end == '\0' || !strcmp(end, ".gz")) && n > last)
+      last = (unsigned)n;
+  }
+  closedir(d);
+  return last;
+}
+
+static int file_open_segment(const char *path, bool truncate) {
+  int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC;
+  return open(path, truncate ? flags | O_TRUNC : flags, 0644);
+}
+
+// Moves the active file to the next numbered segment and switches to the
+// prepared file. Only renames happen here; closing, compressing, pruning and
+// preparing the following file are left to the rotator thread. Caller holds
+// impl->lock.
+static void file_rotate_locked(FileLoggerImpl *impl) {
+  char segment[PATH_MAX];
+  snprintf(segment, sizeof(segment), "%s.%u", impl->path, impl->seq + 1);
+  if (rename(impl->path, segment) != 0) {
+    perror("Failed to rotate log file");
+    impl->opened_at = file_monotonic_sec(); // retry at the next deadline
+    return;
+  }
+  impl->seq++;
+
+  int old_fd = impl->fd;
+  if (impl->next_fd >= 0 && rename(impl->next_path, impl->path) == 0) {
+    impl->fd = impl->next_fd;
+  } else {
+    if (impl->next_fd >= 0)
+      close(impl->next_fd);
+    impl->fd = file_open_segment(impl->path, false);
+  }
+  impl->next_fd = -1;
+  if (impl->fd < 0) {
+    perror("Failed to open log file");
+    impl->fd = old_fd; // keep writing into the same file
+    if (rename(segment, impl->path) == 0)
+      impl->seq--;
+    return;
+  }
+  impl->file_bytes = 0;
+  impl->opened_at = file_monotonic_sec();
+
+  if (impl->has_rotator && impl->closed_count < LOG_ROTATE_QUEUE) {
+    impl->closed[impl->closed_count++] = (ClosedSegment){old_fd, impl->seq};
+  } else {
+    // The rotator is behind; it still compresses and prunes this segment
+    // since it retires every number up to impl->seq.
+    if (impl->options.durability == LOG_DURABILITY_FDATASYNC)
+      fdatasync(old_fd);
+    close(old_fd);
+  }
+  if (impl->has_rotator)
+    pthread_cond_signal(&impl->rotate_wake);
+}
+
+static bool file_should_rotate(FileLoggerImpl *impl, size_t pending) {
+  const FileLoggerOptions *o = &impl->options;
+  if (impl->file_bytes == 0)
+    return false;
+  if (o->rotate_bytes && impl->file_bytes + pending > o->rotate_bytes)
+    return true;
+  return o->rotate_interval_sec &&
+         file_monotonic_sec() - impl->opened_at >= o->rotate_interval_sec;
+}
+
+// Writes every segment, resuming after short writes.
+static void file_writev_all(int fd, struct iovec *iov, int count) {
+  while (count > 0) {
+    ssize_t n = writev(fd, iov, count);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      perror("Failed to write log file");
+      return;
+    }
+    while (count > 0 && (size_t)n >= iov->iov_len) {
+      n -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if (count > 0) {
+      iov->iov_base = (char *)iov->iov_base + n;
+      iov->iov_len -= n;
+    }
+  }
+}
+
+// Sends the pending batch plus any extra segments in one writev, then applies
+// the durability mode. Caller holds impl->lock.
+static void file_flush_locked(FileLoggerImpl *impl, struct iovec *extra,
+                              int extra_count) {
+  struct iovec iov[2];
+  int count = 0;
+  size_t pending = impl->len;
+  if (impl->len)
+    iov[count++] = (struct iovec){impl->buf, impl->len};
+  for (int i = 0; i < extra_count; i++) {
+    iov[count++] = extra[i];
+    pending += extra[i].iov_len;
+  }
+  if (count == 0)
+    return;
+  if (file_should_rotate(impl, pending))
+    file_rotate_locked(impl);
+  file_writev_all(impl->fd, iov, count);
+  impl->file_bytes += pending;
+  impl->len = 0;
+  if (impl->options.durability == LOG_DURABILITY_FDATASYNC)
+    fdatasync(impl->fd);
+}
+
+static void file_write(Logger *self, LogLevel level, const char *line,
+                       size_t len) {
+  FileLoggerImpl *impl = self->impl;
+  bool urgent = level >= impl->options.flush_level &&
+                impl->options.durability != LOG_DURABILITY_NONE;
+
+  pthread_mutex_lock(&impl->lock);
+  if (len <= impl->options.buffer_size - impl->len) {
+    memcpy(impl->buf + impl->len, line, len);
+    impl->len += len;
+    if (urgent || impl->len == impl->options.buffer_size)
+      file_flush_locked(impl, NULL, 0);
+  } else {
+    // The entry does not fit: write the batch and the entry together.
+    struct iovec entry = {(void *)line, len};
+    file_flush_locked(impl, &entry, 1);
+  }
+  pthread_mutex_unlock(&impl->lock);
+}
+
 static void file_log(Logger *self, LogLevel level, const char *fmt,
                      va_list args) {
-  FileLoggerImpl *impl = self->impl;
-  time_t now = time(NULL);
-  struct tm *t = localtime(&now);
-  fprintf(impl->fp, "%02d:%02d:%02d [%s] ", t->tm_hour, t->tm_min, t->tm_sec,
-          LOG_LEVEL_NAMES[level]);
-  vfprintf(impl->fp, fmt, args);
-  fprintf(impl->fp, "\n");
-  fflush(impl->fp);
+  size_t len;
+  char *heap;
+  char *line = log_render_line(level, fmt, args, &len, &heap);
+  file_write(self, level, line, len);
+  free(heap);
+}
+
+// Writes out whatever is pending every flush_interval_ms.
+static void *file_flusher(void *arg) {
+  FileLoggerImpl *impl = arg;
+  unsigned interval = impl->options.flush_interval_ms;
+  pthread_mutex_lock(&impl->lock);
+  while (!impl->closing) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += interval / 1000;
+    deadline.tv_nsec += (long)(interval % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000;
+    }
+    pthread_cond_timedwait(&impl->wake, &impl->lock, &deadline);
+    file_flush_locked(impl, NULL, 0);
+  }
+  pthread_mutex_unlock(&impl->lock);
+  return NULL;
+}
+
+// Compresses segments first..last, as few gzip processes as possible.
+static void file_compress_segments(FileLoggerImpl *impl, unsigned first,
+                                   unsigned last) {
+  enum { BATCH = 32 };
+  char paths[BATCH][PATH_MAX];
+  char *argv[BATCH + 4] = {"gzip", "-f", "-q"};
+  while (first <= last) {
+    int count = 0;
+    for (; count < BATCH && first <= last; count++, first++) {
+      snprintf(paths[count], PATH_MAX, "%s.%u", impl->path, first);
+      argv[3 + count] = paths[count];
+    }
+    argv[3 + count] = NULL;
+    pid_t pid;
+    if (posix_spawnp(&pid, "gzip", NULL, NULL, argv, environ) == 0)
+      waitpid(pid, NULL, 0);
+  }
+}
+
+// Drops segments past the retention limit, newest first down to the point
+// where earlier rotations already pruned.
+static void file_prune_segments(FileLoggerImpl *impl, unsigned last) {
+  unsigned keep = impl->options.max_segments;
+  char path[PATH_MAX];
+  if (keep == 0 || last <= keep)
+    return;
+  for (unsigned n = last - keep; n > 0; n--) {
+    snprintf(path, sizeof(path), "%s.%u", impl->path, n);
+    bool removed = unlink(path) == 0;
+    snprintf(path, sizeof(path), "%s.%u.gz", impl->path, n);
+    removed |= unlink(path) == 0;
+    if (!removed)
+      break;
+  }
+}
+
+// Background half of rotation, so producers never wait on it. Each pass
+// closes the queued fds, then compresses and prunes every segment rotated
+// since the last pass, including ones whose fd the producer had to close
+// itself because the queue was full.
+static void *file_rotator(void *arg) {
+  FileLoggerImpl *impl = arg;
+  pthread_mutex_lock(&impl->lock);
+  for (;;) {
+    while (!impl->closing && impl->closed_count == 0 &&
+           impl->retired == impl->seq && impl->next_fd >= 0)
+      pthread_cond_wait(&impl->rotate_wake, &impl->lock);
+    if (impl->closing && impl->closed_count == 0 &&
+        impl->retired == impl->seq)
+      break;
+
+    ClosedSegment closed[LOG_ROTATE_QUEUE];
+    size_t count = impl->closed_count;
+    memcpy(closed, impl->closed, count * sizeof(ClosedSegment));
+    impl->closed_count = 0;
+    unsigned first = impl->retired + 1, last = impl->seq;
+    bool prepare = impl->next_fd < 0 && !impl->closing;
+    pthread_mutex_unlock(&impl->lock);
+
+    int fd = -1;
+    if (prepare) {
+      fd = file_open_segment(impl->next_path, true);
+      if (fd >= 0 && impl->options.rotate_bytes)
+        fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, impl->options.rotate_bytes);
+    }
+    for (size_t i = 0; i < count; i++) {
+      if (impl->options.durability == LOG_DURABILITY_FDATASYNC)
+        fdatasync(closed[i].fd);
+      close(closed[i].fd);
+    }
+    if (first <= last) {
+      if (impl->options.compress)
+        file_compress_segments(impl, first, last);
+      file_prune_segments(impl, last);
+    }
+
+    pthread_mutex_lock(&impl->lock);
+    impl->retired = last;
+    if (prepare)
+      impl->next_fd = fd;
+    if (fd < 0 && prepare && !impl->closing) {
+      // Could not prepare; the producer opens the file itself on rotation.
+      while (!impl->closing && impl->closed_count == 0 &&
+             impl->retired == impl->seq)
+        pthread_cond_wait(&impl->rotate_wake, &impl->lock);
+    }
+  }
+  pthread_mutex_unlock(&impl->lock);
+  return NULL;
 }
 
 static void file_close(Logger *self) {
   FileLoggerImpl *impl = self->impl;
-  if (impl->fp)
-    fclose(impl->fp);
+  pthread_mutex_lock(&impl->lock);
+  impl->closing = true;
+  pthread_cond_signal(&impl->wake);
+  pthread_cond_signal(&impl->rotate_wake);
+  pthread_mutex_unlock(&impl->lock);
+  if (impl->has_flusher)
+    pthread_join(impl->flusher, NULL);
+  if (impl->has_rotator)
+    pthread_join(impl->rotator, NULL);
+
+  file_flush_locked(impl, NULL, 0);
+  if (impl->options.durability != LOG_DURABILITY_NONE)
+    fdatasync(impl->fd);
+  close(impl->fd);
+  if (impl->next_fd >= 0) {
+    close(impl->next_fd);
+    unlink(impl->next_path);
+  }
+  free(impl->buf);
+  free(impl->path);
+  free(impl->next_path);
+  pthread_cond_destroy(&impl->wake);
+  pthread_cond_destroy(&impl->rotate_wake);
+  pthread_mutex_destroy(&impl->lock);
+  free(impl);
 }
 
-Logger make_file_logger(const char *filename) {
-  static FileLoggerImpl impl;
-  impl.fp = fopen(filename, "a");
-  if (!impl.fp) {
+static bool file_open(Logger *out, const char *filename,
+                      FileLoggerOptions options) {
+  FileLoggerImpl *impl = calloc(1, sizeof(*impl));
+  if (!impl)
+    return false;
+  if (options.buffer_size < LOG_LINE_MAX)
+    options.buffer_size = LOG_LINE_MAX;
+  impl->options = options;
+  impl->fd = file_open_segment(filename, false);
+  if (impl->fd >= 0) {
+    impl->buf = malloc(options.buffer_size);
+    impl->path = strdup(filename);
+    impl->next_path = malloc(strlen(filename) + sizeof(".next"));
+  }
+  if (impl->fd < 0 || !impl->buf || !impl->path || !impl->next_path) {
+    int error = impl->fd < 0 ? errno : ENOMEM;
+    if (impl->fd >= 0)
+      close(impl->fd);
+    free(impl->buf);
+    free(impl->path);
+    free(impl->next_path);
+    free(impl);
+    errno = error;
+    return false;
+  }
+  sprintf(impl->next_path, "%s.next", filename);
+
+  struct stat st;
+  impl->file_bytes = fstat(impl->fd, &st) == 0 ? (size_t)st.st_size : 0;
+  impl->opened_at = file_monotonic_sec();
+  impl->next_fd = -1;
+
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&impl->wake, &attr);
+  pthread_condattr_destroy(&attr);
+  pthread_cond_init(&impl->rotate_wake, NULL);
+  pthread_mutex_init(&impl->lock, NULL);
+  impl->has_flusher =
+      options.flush_interval_ms > 0 &&
+      options.durability != LOG_DURABILITY_NONE &&
+      pthread_create(&impl->flusher, NULL, file_flusher, impl) == 0;
+  if (options.rotate_bytes || options.rotate_interval_sec) {
+    impl->seq = file_last_segment(filename);
+    impl->retired = impl->seq;
+    impl->has_rotator =
+        pthread_create(&impl->rotator, NULL, file_rotator, impl) == 0;
+  }
+
+  *out = (Logger){file_log, file_write, file_close, impl};
+  return true;
+}
+
+Logger make_file_logger_with_options(const char *filename,
+                                     FileLoggerOptions options) {
+  Logger logger;
+  if (!file_open(&logger, filename, options)) {
     perror("Failed to open log file");
     exit(EXIT_FAILURE);
   }
-  Logger logger = {file_log, file_close, &impl};
   return logger;
 }
 
+Logger make_file_logger(const char *filename) {
+  return make_file_logger_with_options(
+      filename, (FileLoggerOptions)DEFAULT_FILE_LOGGER_OPTIONS);
+}
+
 // ===== Multi Logger (fan-out) =====
 typedef struct {
   Logger *targets;
@@ -95,28 +621,665 @@ static void multi_log(Logger *self, LogLevel level, const char *fmt,
   }
 }
 
+static void multi_write(Logger *self, LogLevel level, const char *line,
+                        size_t len) {
+  MultiLoggerImpl *impl = self->impl;
+  for (size_t i = 0; i < impl->count; i++) {
+    impl->targets[i].write(&impl->targets[i], level, line, len);
+  }
+}
+
 static void multi_close(Logger *self) {
   MultiLoggerImpl *impl = self->impl;
   for (size_t i = 0; i < impl->count; i++) {
     impl->targets[i].close(&impl->targets[i]);
   }
+  free(impl);
 }
 
+// The targets are copied, so the caller's array may go out of scope.
 Logger make_multi_logger(Logger *targets, size_t count) {
-  static MultiLoggerImpl impl;
-  impl.targets = targets;
-  impl.count = count;
-  Logger logger = {multi_log, multi_close, &impl};
+  MultiLoggerImpl *impl = malloc(sizeof(*impl) + count * sizeof(Logger));
+  if (!impl) {
+    perror("Failed to create multi logger");
+    exit(EXIT_FAILURE);
+  }
+  impl->targets = (Logger *)(impl + 1);
+  impl->count = count;
+  memcpy(impl->targets, targets, count * sizeof(Logger));
+  Logger logger = {multi_log, multi_write, multi_close, impl};
   return logger;
 }
 
+// ===== Format Registry =====
+typedef struct {
+  const char *fmt;
+  int nargs; // -1: not encodable, recorded as preformatted text
+  uint8_t kinds[LOG_MAX_ARGS];
+} LogFormat;
+
+static LogFormat FORMATS[LOG_MAX_FORMATS];
+static uint16_t FORMAT_COUNT;
+// Open-addressed map from format pointer to id + 1 (0 = empty slot). Lookups
+// are lock-free; only registering a new format takes FORMAT_LOCK.
+static _Atomic uint16_t FORMAT_SLOTS[LOG_MAX_FORMATS * 2];
+static pthread_mutex_t FORMAT_LOCK = PTHREAD_MUTEX_INITIALIZER;
+
+// Consumes one conversion spec starting after '%'. Returns a pointer past it
+// and stores the va_arg kinds it needs (up to 3 with '*' width/precision).
+static const char *log_scan_spec(const char *p, uint8_t *kinds, int *count,
+                                 int *error) {
+  *count = 0;
+  while (*p && strchr("-+ #0'", *p))
+    p++;
+  if (*p == '*') {
+    kinds[(*count)++] = LOG_ARG_INT;
+    p++;
+  }
+  while (*p >= '0' && *p <= '9')
+    p++;
+  if (*p == '.') {
+    p++;
+    if (*p == '*') {
+      kinds[(*count)++] = LOG_ARG_INT;
+      p++;
+    }
+    while (*p >= '0' && *p <= '9')
+      p++;
+  }
+
+  int length = 0; // 'H' hh, 'h', 'l', 'q' ll, 'j', 'z', 't', 'L'
+  switch (*p) {
+  case 'h':
+    length = p[1] == 'h' ? 'H' : 'h';
+    p += length == 'H' ? 2 : 1;
+    break;
+  case 'l':
+    length = p[1] == 'l' ? 'q' : 'l';
+    p += length == 'q' ? 2 : 1;
+    break;
+  case 'j':
+  case 'z':
+  case 't':
+  case 'L':
+    length = *p++;
+    break;
+  }
+
+  uint8_t kind;
+  switch (*p) {
+  case 'd':
+  case 'i':
+  case 'u':
+  case 'o':
+  case 'x':
+  case 'X':
+  case 'c':
+    kind = length == 'l'   ? LOG_ARG_LONG
+           : length == 'q' ? LOG_ARG_LLONG
+           : length == 'z' ? LOG_ARG_SIZE
+           : length == 'j' ? LOG_ARG_INTMAX
+           : length == 't' ? LOG_ARG_PTRDIFF
+                           : LOG_ARG_INT;
+    break;
+  case 'f':
+  case 'F':
+  case 'e':
+  case 'E':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    kind = length == 'L' ? LOG_ARG_LDOUBLE : LOG_ARG_DOUBLE;
+    break;
+  case 's':
+    kind = LOG_ARG_STRING;
+    break;
+  case 'p':
+    kind = LOG_ARG_POINTER;
+    break;
+  default: // %n, %ls, %lc and anything unknown
+    *error = 1;
+    return *p ? p + 1 : p;
+  }
+  if (length == 'l' && (*p == 'c' || *p == 's'))
+    *error = 1;
+  kinds[(*count)++] = kind;
+  return p + 1;
+}
+
+int log_format_arg_kinds(const char *fmt, uint8_t *kinds, size_t max) {
+  size_t n = 0;
+  int error = 0;
+  for (const char *p = fmt; *p;) {
+    if (*p++ != '%')
+      continue;
+    if (*p == '%') {
+      p++;
+      continue;
+    }
+    uint8_t spec[3];
+    int count;
+    p = log_scan_spec(p, spec, &count, &error);
+    if (error || n + count > max)
+      return -1;
+    memcpy(kinds + n, spec, count);
+    n += count;
+  }
+  return (int)n;
+}
+
+static size_t log_format_slot(const char *fmt) {
+  return ((uintptr_t)fmt >> 3) * 0x9E3779B97F4A7C15ull >> 51; // 13 bits
+}
+
+// Returns the slot holding fmt, or the empty slot where it would go.
+static size_t log_format_find(const char *fmt, uint16_t *entry) {
+  size_t mask = LOG_MAX_FORMATS * 2 - 1;
+  size_t slot = log_format_slot(fmt) & mask;
+  for (;; slot = (slot + 1) & mask) {
+    *entry = atomic_load_explicit(&FORMAT_SLOTS[slot], memory_order_acquire);
+    if (*entry == 0 || FORMATS[*entry - 1].fmt == fmt)
+      return slot;
+  }
+}
+
+// Returns the id for fmt, registering it on first use. UINT16_MAX when the
+// registry is full.
+static uint16_t log_format_id(const char *fmt) {
+  uint16_t entry;
+  size_t slot = log_format_find(fmt, &entry);
+  if (entry)
+    return entry - 1;
+
+  pthread_mutex_lock(&FORMAT_LOCK);
+  slot = log_format_find(fmt, &entry); // another thread may have won
+  uint16_t id = entry ? entry - 1 : UINT16_MAX;
+  if (!entry && FORMAT_COUNT < LOG_MAX_FORMATS) {
+    id = FORMAT_COUNT++;
+    FORMATS[id].fmt = fmt;
+    FORMATS[id].nargs =
+        log_format_arg_kinds(fmt, FORMATS[id].kinds, LOG_MAX_ARGS);
+    atomic_store_explicit(&FORMAT_SLOTS[slot], id + 1, memory_order_release);
+  }
+  pthread_mutex_unlock(&FORMAT_LOCK);
+  return id;
+}
+
+uint16_t log_register_format(const char *fmt) { return log_format_id(fmt); }
+
+// ===== Binary Logger =====
+#define LOG_BIN_RECORD_MAX LOG_LINE_MAX // encoded in the thread scratch buffer
+
+typedef struct {
+  int fd;
+  char *buf;
+  size_t cap;
+  size_t len;
+  pthread_mutex_t lock;
+  uint8_t defined[LOG_MAX_FORMATS / 8]; // ids already written to this file
+} BinaryLoggerImpl;
+
+// Format of pre-rendered lines and of messages that cannot be encoded.
+// Registered when a binary logger is created, so it has an id even once
+// the registry is full.
+static const char *const BINARY_LINE_FORMAT = "%s";
+
+static void binary_write(Logger *self, LogLevel level, const char *line,
+                         size_t len);
+
+// Caller holds impl->lock (or is closing the logger).
+static void binary_flush(BinaryLoggerImpl *impl) {
+  size_t off = 0;
+  while (off < impl->len) {
+    ssize_t n = write(impl->fd, impl->buf + off, impl->len - off);
+    if (n < 0) {
+      perror("Failed to write binary log");
+      break;
+    }
+    off += (size_t)n;
+  }
+  impl->len = 0;
+}
+
+static void binary_append(BinaryLoggerImpl *impl, uint8_t type, LogLevel level,
+                          uint16_t id, uint64_t time_ns, const void *payload,
+                          size_t size) {
+  LogBinRecord rec = {type, (uint8_t)level, id, (uint32_t)size, time_ns};
+  memcpy(impl->buf + impl->len, &rec, sizeof(rec));
+  memcpy(impl->buf + impl->len + sizeof(rec), payload, size);
+  impl->len += sizeof(rec) + size;
+}
+
+// Encodes args into out according to kinds; strings are cut to fit.
+static size_t binary_encode_args(char *out, size_t cap, const uint8_t *kinds,
+                                 int nargs, va_list args) {
+  size_t len = 0;
+  for (int i = 0; i < nargs; i++) {
+    int64_t v;
+    switch (kinds[i]) {
+    case LOG_ARG_INT: {
+      int x = va_arg(args, int);
+      if (len + sizeof(x) <= cap)
+        memcpy(out + len, &x, sizeof(x));
+      len += sizeof(x);
+      continue;
+    }
+    case LOG_ARG_LONG:
+      v = va_arg(args, long);
+      break;
+    case LOG_ARG_LLONG:
+      v = va_arg(args, long long);
+      break;
+    case LOG_ARG_SIZE:
+      v = (int64_t)va_arg(args, size_t);
+      break;
+    case LOG_ARG_INTMAX:
+      v = va_arg(args, intmax_t);
+      break;
+    case LOG_ARG_PTRDIFF:
+      v = va_arg(args, ptrdiff_t);
+      break;
+    case LOG_ARG_POINTER:
+      v = (int64_t)(uintptr_t)va_arg(args, void *);
+      break;
+    case LOG_ARG_DOUBLE:
+    case LOG_ARG_LDOUBLE: {
+      double d = kinds[i] == LOG_ARG_DOUBLE ? va_arg(args, double)
+                                            : (double)va_arg(args, long double);
+      if (len + sizeof(d) <= cap)
+        memcpy(out + len, &d, sizeof(d));
+      len += sizeof(d);
+      continue;
+    }
+    default: { // LOG_ARG_STRING
+      const char *s = va_arg(args, const char *);
+      if (!s)
+        s = "(null)";
+      size_t room = len + sizeof(uint16_t) < cap ? cap - len - sizeof(uint16_t)
+                                                 : 0;
+      size_t n = strnlen(s, room < UINT16_MAX ? room : UINT16_MAX);
+      uint16_t n16 = (uint16_t)n;
+      if (len + sizeof(n16) <= cap) {
+        memcpy(out + len, &n16, sizeof(n16));
+        memcpy(out + len + sizeof(n16), s, n);
+      }
+      len += sizeof(n16) + n;
+      continue;
+    }
+    }
+    if (len + sizeof(v) <= cap)
+      memcpy(out + len, &v, sizeof(v));
+    len += sizeof(v);
+  }
+  return len <= cap ? len : cap;
+}
+
+static void binary_log(Logger *self, LogLevel level, const char *fmt,
+                       va_list args) {
+  BinaryLoggerImpl *impl = self->impl;
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  uint64_t time_ns = (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+
+  uint16_t id = log_format_id(fmt);
+  if (id == UINT16_MAX || FORMATS[id].nargs < 0) {
+    // Not encodable: store the formatted text as a pre-rendered line.
+    char text[LOG_BIN_RECORD_MAX / 2];
+    int n = vsnprintf(text, sizeof(text), fmt, args);
+    if (n < 0)
+      return;
+    binary_write(self, level, text,
+                 (size_t)n < sizeof(text) ? (size_t)n : sizeof(text) - 1);
+    return;
+  }
+
+  // Arguments are encoded into the thread's scratch buffer, outside the lock.
+  size_t size = binary_encode_args(LINE_BUF, LOG_BIN_RECORD_MAX,
+                                   FORMATS[id].kinds, FORMATS[id].nargs, args);
+
+  pthread_mutex_lock(&impl->lock);
+  size_t fmt_len = 0;
+  bool defined = impl->defined[id / 8] & (1u << (id % 8));
+  if (!defined)
+    fmt_len = strnlen(fmt, LOG_BIN_RECORD_MAX);
+  if (impl->cap - impl->len <
+      2 * sizeof(LogBinRecord) + fmt_len + LOG_BIN_RECORD_MAX)
+    binary_flush(impl);
+  if (!defined) {
+    binary_append(impl, LOG_REC_FORMAT, 0, id, 0, fmt, fmt_len);
+    impl->defined[id / 8] |= 1u << (id % 8);
+  }
+  binary_append(impl, LOG_REC_MESSAGE, level, id, time_ns, LINE_BUF, size);
+  pthread_mutex_unlock(&impl->lock);
+}
+
+// Pre-rendered lines are stored as the argument of a "%s" message.
+static void binary_write(Logger *self, LogLevel level, const char *line,
+                         size_t len) {
+  BinaryLoggerImpl *impl = self->impl;
+  uint16_t id = log_format_id(BINARY_LINE_FORMAT);
+  if (id == UINT16_MAX)
+    return;
+  if (len && line[len - 1] == '\n')
+    len--;
+  if (len > LOG_BIN_RECORD_MAX - sizeof(uint16_t))
+    len = LOG_BIN_RECORD_MAX - sizeof(uint16_t);
+  uint16_t n16 = (uint16_t)len;
+
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  LogBinRecord rec = {LOG_REC_MESSAGE, (uint8_t)level, id,
+                      (uint32_t)(sizeof(n16) + len),
+                      (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec};
+
+  pthread_mutex_lock(&impl->lock);
+  if (impl->cap - impl->len < 2 * sizeof(LogBinRecord) + LOG_BIN_RECORD_MAX + 2)
+    binary_flush(impl);
+  if (!(impl->defined[id / 8] & (1u << (id % 8)))) {
+    binary_append(impl, LOG_REC_FORMAT, 0, id, 0, BINARY_LINE_FORMAT, 2);
+    impl->defined[id / 8] |= 1u << (id % 8);
+  }
+  char *out = impl->buf + impl->len;
+  memcpy(out, &rec, sizeof(rec));
+  memcpy(out + sizeof(rec), &n16, sizeof(n16));
+  memcpy(out + sizeof(rec) + sizeof(n16), line, len);
+  impl->len += sizeof(rec) + rec.size;
+  pthread_mutex_unlock(&impl->lock);
+}
+
+static void binary_close(Logger *self) {
+  BinaryLoggerImpl *impl = self->impl;
+  binary_flush(impl);
+  close(impl->fd);
+  free(impl->buf);
+  pthread_mutex_destroy(&impl->lock);
+  free(impl);
+}
+
+Logger make_binary_logger(const char *filename, size_t buffer_size) {
+  BinaryLoggerImpl *impl = calloc(1, sizeof(*impl));
+  if (!impl) {
+    perror("Failed to create binary logger");
+    exit(EXIT_FAILURE);
+  }
+  size_t min = 4 * (LOG_BIN_RECORD_MAX + sizeof(LogBinRecord));
+  impl->cap = buffer_size > min ? buffer_size : min;
+  impl->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  impl->buf = malloc(impl->cap);
+  if (impl->fd < 0 || !impl->buf) {
+    perror("Failed to open binary log");
+    exit(EXIT_FAILURE);
+  }
+  pthread_mutex_init(&impl->lock, NULL);
+  log_format_id(BINARY_LINE_FORMAT);
+  memcpy(impl->buf, LOG_BIN_MAGIC, LOG_BIN_MAGIC_LEN);
+  impl->len = LOG_BIN_MAGIC_LEN;
+  Logger logger = {binary_log, binary_write, binary_close, impl};
+  return logger;
+}
+
+// ===== Structured Logging =====
+static _Atomic LogEncoding FIELD_ENCODING = LOG_ENCODING_JSON;
+
+void log_set_field_encoding(LogEncoding encoding) {
+  atomic_store_explicit(&FIELD_ENCODING, encoding, memory_order_relaxed);
+}
+
+// Output cursor over the thread's scratch buffer; moves to the heap only if
+// a record outgrows it.
+typedef struct {
+  char *buf;
+  size_t len;
+  size_t cap;
+  bool json; // FIELD_ENCODING, read once so a record never mixes encodings
+} LogWriter;
+
+static bool log_reserve(LogWriter *w, size_t n) {
+  if (w->len + n <= w->cap)
+    return true;
+  size_t cap = w->cap * 2 > w->len + n ? w->cap * 2 : w->len + n;
+  char *buf = w->buf == LINE_BUF ? malloc(cap) : realloc(w->buf, cap);
+  if (!buf)
+    return false;
+  if (w->buf == LINE_BUF)
+    memcpy(buf, LINE_BUF, w->len);
+  w->buf = buf;
+  w->cap = cap;
+  return true;
+}
+
+static void log_put(LogWriter *w, const char *s, size_t n) {
+  if (log_reserve(w, n)) {
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+  }
+}
+
+static void log_put_char(LogWriter *w, char c) {
+  if (log_reserve(w, 1))
+    w->buf[w->len++] = c;
+}
+
+static void log_put_int(LogWriter *w, int64_t v) {
+  char digits[24];
+  char *p = digits + sizeof(digits);
+  uint64_t u = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+  do {
+    *--p = (char)('0' + u % 10);
+    u /= 10;
+  } while (u);
+  if (v < 0)
+    *--p = '-';
+  log_put(w, p, digits + sizeof(digits) - p);
+}
+
+// Bytes that need escaping inside a JSON string or a quoted logfmt value.
+// logfmt also quotes values containing these or a space or '='.
+static bool log_needs_escape(unsigned char c) {
+  return c < 0x20 || c == '"' || c == '\\' || c == 0x7f;
+}
+
+// Copies clean runs with one memcpy and escapes only the bytes that need it.
+static void log_put_escaped(LogWriter *w, const char *s, size_t n) {
+  static const char HEX[] = "0123456789abcdef";
+  size_t run = 0;
+  for (size_t i = 0; i < n; i++) {
+    unsigned char c = (unsigned char)s[i];
+    if (!log_needs_escape(c))
+      continue;
+    log_put(w, s + run, i - run);
+    run = i + 1;
+    switch (c) {
+    case '"':
+      log_put(w, "\\\"", 2);
+      break;
+    case '\\':
+      log_put(w, "\\\\", 2);
+      break;
+    case '\n':
+      log_put(w, "\\n", 2);
+      break;
+    case '\t':
+      log_put(w, "\\t", 2);
+      break;
+    case '\r':
+      log_put(w, "\\r", 2);
+      break;
+    default: {
+      char u[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 15]};
+      log_put(w, u, sizeof(u));
+    }
+    }
+  }
+  log_put(w, s + run, n - run);
+}
+
+static void log_put_string(LogWriter *w, const char *s, size_t n) {
+  bool quote = w->json || n == 0;
+  for (size_t i = 0; i < n && !quote; i++)
+    quote = s[i] == ' ' || s[i] == '=' || log_needs_escape(s[i]);
+  if (!quote) {
+    log_put(w, s, n);
+    return;
+  }
+  log_put_char(w, '"');
+  log_put_escaped(w, s, n);
+  log_put_char(w, '"');
+}
+
+static void log_put_value(LogWriter *w, const LogField *f) {
+  switch (f->type) {
+  case LOG_FIELD_INT:
+    log_put_int(w, f->i);
+    break;
+  case LOG_FIELD_DOUBLE:
+    if (!isfinite(f->d)) {
+      log_put_string(w, isnan(f->d) ? "NaN" : f->d > 0 ? "Inf" : "-Inf",
+                     isnan(f->d) || f->d > 0 ? 3 : 4);
+    } else if (log_reserve(w, 32)) {
+      w->len += snprintf(w->buf + w->len, 32, "%.17g", f->d);
+    }
+    break;
+  case LOG_FIELD_STRING: {
+    const char *s = f->s.ptr ? f->s.ptr : "";
+    log_put_string(w, s, f->s.len == SIZE_MAX ? strlen(s) : f->s.len);
+    break;
+  }
+  case LOG_FIELD_BYTES: { // hex
+    static const char HEX[] = "0123456789abcdef";
+    const unsigned char *p = (const unsigned char *)f->s.ptr;
+    bool quote = w->json;
+    if (quote)
+      log_put_char(w, '"');
+    if (log_reserve(w, 2 * f->s.len)) {
+      for (size_t i = 0; i < f->s.len; i++) {
+        w->buf[w->len++] = HEX[p[i] >> 4];
+        w->buf[w->len++] = HEX[p[i] & 15];
+      }
+    }
+    if (quote)
+      log_put_char(w, '"');
+    break;
+  }
+  }
+}
+
+static void log_put_key(LogWriter *w, const char *key, bool first) {
+  if (w->json) {
+    log_put(w, first ? "\"" : ",\"", first ? 1 : 2);
+    log_put_escaped(w, key, strlen(key));
+    log_put(w, "\":", 2);
+  } else {
+    if (!first)
+      log_put_char(w, ' ');
+    log_put(w, key, strlen(key));
+    log_put_char(w, '=');
+  }
+}
+
+void log_fields(Logger *logger, LogLevel level, const char *msg,
+                const LogField *fields, size_t count) {
+  if (!log_enabled(level))
+    return;
+
+  LogEncoding encoding =
+      atomic_load_explicit(&FIELD_ENCODING, memory_order_relaxed);
+  LogWriter w = {LINE_BUF, 0, LOG_LINE_MAX, encoding == LOG_ENCODING_JSON};
+  char stamp[LOG_TIME_MAX];
+  size_t stamp_len = log_format_time(stamp);
+  const char *name = LOG_LEVEL_NAMES[level];
+  LogField header[] = {
+      {.key = "ts", .type = LOG_FIELD_STRING, .s = {stamp, stamp_len}},
+      {.key = "level", .type = LOG_FIELD_STRING, .s = {name, strlen(name)}},
+      {.key = "msg", .type = LOG_FIELD_STRING, .s = {msg, SIZE_MAX}},
+  };
+
+  if (w.json)
+    log_put_char(&w, '{');
+  for (size_t i = 0; i < 3 + count; i++) {
+    const LogField *f = i < 3 ? &header[i] : &fields[i - 3];
+    log_put_key(&w, f->key, i == 0);
+    log_put_value(&w, f);
+  }
+  if (w.json)
+    log_put_char(&w, '}');
+  log_put_char(&w, '\n');
+
+  logger->write(logger, level, w.buf, w.len);
+  if (w.buf != LINE_BUF)
+    free(w.buf);
+}
+
+// ===== Rate Limiting and Sampling =====
+#ifdef CLOCK_MONOTONIC_COARSE
+#define LOG_CLOCK_SITE CLOCK_MONOTONIC_COARSE
+#else
+#define LOG_CLOCK_SITE CLOCK_MONOTONIC
+#endif
+
+static uint64_t log_site_now(void) {
+  struct timespec ts;
+  clock_gettime(LOG_CLOCK_SITE, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+bool log_site_allow(LogSite *site, double rate, unsigned burst) {
+  uint64_t interval = rate > 0 ? (uint64_t)(1e9 / rate) : UINT64_MAX / 4;
+  uint64_t tolerance = interval * (burst > 1 ? burst - 1 : 0);
+  uint64_t now = log_site_now();
+  uint64_t tat = atomic_load_explicit(&site->tat, memory_order_relaxed);
+  do {
+    uint64_t start = tat > now ? tat : now;
+    if (start - now > tolerance) {
+      atomic_fetch_add_explicit(&site->suppressed, 1, memory_order_relaxed);
+      return false;
+    }
+    if (atomic_compare_exchange_weak_explicit(&site->tat, &tat,
+                                              start + interval,
+                                              memory_order_relaxed,
+                                              memory_order_relaxed))
+      return true;
+  } while (1);
+}
+
+bool log_site_sample(LogSite *site, unsigned n) {
+  uint64_t call =
+      atomic_fetch_add_explicit(&site->calls, 1, memory_order_relaxed);
+  if (n <= 1 || call % n == 0)
+    return true;
+  atomic_fetch_add_explicit(&site->suppressed, 1, memory_order_relaxed);
+  return false;
+}
+
+void log_site_summary(Logger *logger, LogLevel level, LogSite *site,
+                      const char *file, int line) {
+  if (atomic_load_explicit(&site->suppressed, memory_order_relaxed) == 0)
+    return;
+  uint64_t now = log_site_now();
+  uint64_t last = atomic_load_explicit(&site->summary_at, memory_order_relaxed);
+  if (last && now - last < LOG_SUMMARY_INTERVAL_NS)
+    return;
+  if (!atomic_compare_exchange_strong_explicit(
+          &site->summary_at, &last, now, memory_order_relaxed,
+          memory_order_relaxed))
+    return; // another thread is reporting
+  uint64_t n = atomic_exchange_explicit(&site->suppressed, 0,
+                                        memory_order_relaxed);
+  if (n)
+    log_message(logger, level, "%s:%d: suppressed %llu messages", file, line,
+                (unsigned long long)n);
+}
+
 // ===== Public Logging API =====
-static LogLevel CURRENT_LEVEL = LOG_DEBUG;
+_Atomic LogLevel LOG_CURRENT_LEVEL = LOG_DEBUG;
 
-void log_set_level(LogLevel level) { CURRENT_LEVEL = level; }
+void log_set_level(LogLevel level) {
+  atomic_store_explicit(&LOG_CURRENT_LEVEL, level, memory_order_relaxed);
+}
 
 void log_message(Logger *logger, LogLevel level, const char *fmt, ...) {
-  if (level < CURRENT_LEVEL)
+  if (!log_enabled(level))
     return;
   va_list args;
   va_start(args, fmt);
@@ -124,6 +1287,60 @@ void log_message(Logger *logger, LogLevel level, const char *fmt, ...) {
   va_end(args);
 }
 
+// ===== Batch Submission =====
+void log_submit_batch(Logger *logger, const LogRecord *records, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    LogLevel level = (LogLevel)records[i].level;
+    if ((unsigned)level > LOG_ERROR || !log_enabled(level))
+      continue;
+    size_t prefix_len = log_format_time(LINE_BUF);
+    prefix_len += snprintf(LINE_BUF + prefix_len, LOG_LINE_MAX - prefix_len,
+                           " [%s] ", LOG_LEVEL_NAMES[level]);
+    size_t len = prefix_len + records[i].length + 1;
+    char *line = len <= LOG_LINE_MAX ? LINE_BUF : malloc(len);
+    if (!line)
+      continue;
+    if (line != LINE_BUF)
+      memcpy(line, LINE_BUF, prefix_len);
+    memcpy(line + prefix_len, records[i].message, records[i].length);
+    line[len - 1] = '\n';
+    logger->write(logger, level, line, len);
+    if (line != LINE_BUF)
+      free(line);
+  }
+}
+
+// ===== C ABI (shared library) =====
+// NULL with errno set on failure; these never exit the host process.
+static Logger *logger_box(Logger logger) {
+  Logger *boxed = malloc(sizeof(*boxed));
+  if (!boxed) {
+    logger.close(&logger);
+    errno = ENOMEM;
+    return NULL;
+  }
+  *boxed = logger;
+  return boxed;
+}
+
+Logger *logger_open_console(void) {
+  Logger logger;
+  return console_open(&logger, stdout) ? logger_box(logger) : NULL;
+}
+
+Logger *logger_open_file(const char *filename) {
+  Logger logger;
+  return file_open(&logger, filename,
+                   (FileLoggerOptions)DEFAULT_FILE_LOGGER_OPTIONS)
+             ? logger_box(logger)
+             : NULL;
+}
+
+void logger_close(Logger *logger) {
+  logger->close(logger);
+  free(logger);
+}
+
 // ===== Example Usage =====
 #ifdef LOGGER_MAIN
 int main(void) {
@@ -134,13 +1351,23 @@ int main(void) {
   Logger multi = make_multi_logger(targets, 2);
 
   log_set_level(LOG_DEBUG);
+  log_set_time_format(LOG_TIME_HMS, LOG_TIME_USEC);
 
-  log_message(&multi, LOG_INFO, "Application started");
-  log_message(&multi, LOG_DEBUG, "Debugging value: %d", 42);
-  log_message(&multi, LOG_WARN, "Low disk space");
-  log_message(&multi, LOG_ERROR, "Fatal error: %s", "Out of memory");
+  LOG_INFO(&multi, "Application started");
+  LOG_DEBUG(&multi, "Debugging value: %d", 42);
+  LOG_WARN(&multi, "Low disk space");
+  LOG_ERROR(&multi, "Fatal error: %s", "Out of memory");
+  LOG_FIELDS(&multi, LOG_INFO, "Disk check", LOG_STR("mount", "/"),
+             LOG_INT("free_mb", 512), LOG_DOUBLE("used_pct", 93.5));
 
   multi.close(&multi);
+
+  // Binary target: decode with `logdecode app.bin`
+  Logger binary = make_binary_logger("app.bin", 1 << 20);
+  for (int i = 0; i < 3; i++)
+    log_message(&binary, LOG_INFO, "Request %d took %.3f ms (%s)", i,
+                1.25 * i, "GET /");
+  binary.close(&binary);
   return 0;
 }
 #endif
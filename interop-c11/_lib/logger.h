@@ -0,0 +1,300 @@
+// logger.h — General Logger Utility in C11
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ===== Log Levels =====
+typedef enum { LOG_DEBUG, LOG_INFO, LOG_WARN, LOG_ERROR } LogLevel;
+
+// ===== Timestamps =====
+typedef enum { LOG_TIME_HMS, LOG_TIME_ISO8601 } LogTimeFormat;
+
+// Sub-second suffix appended after the cached prefix. LOG_TIME_MONO appends
+// CLOCK_MONOTONIC nanoseconds instead, which orders bursts across clock steps.
+typedef enum {
+  LOG_TIME_SEC,
+  LOG_TIME_USEC,
+  LOG_TIME_NSEC,
+  LOG_TIME_MONO
+} LogTimePrecision;
+
+// ===== Logger Interface =====
+typedef struct Logger {
+  void (*log)(struct Logger *self, LogLevel level, const char *fmt,
+              va_list args);
+  // Emits an already rendered line (including its trailing newline).
+  void (*write)(struct Logger *self, LogLevel level, const char *line,
+                size_t len);
+  void (*close)(struct Logger *self);
+  void *impl; // implementation-specific data
+} Logger;
+
+// ===== File Logger Options =====
+// What happens to a batch once it is written. NONE leaves lines in the
+// user-space buffer until it fills (or the logger closes); FLUSH hands each
+// batch to the kernel; FDATASYNC also waits for it to reach the disk.
+typedef enum {
+  LOG_DURABILITY_NONE,
+  LOG_DURABILITY_FLUSH,
+  LOG_DURABILITY_FDATASYNC
+} LogDurability;
+
+// Rotation moves the active file to filename.1, filename.2, ... (gzipped in
+// the background when compress is set) and continues in a fresh filename
+// that was preallocated ahead of time. Both triggers are off by default.
+typedef struct {
+  size_t buffer_size;         // batch is written when this fills
+  unsigned flush_interval_ms; // and at least this often (0 disables)
+  LogLevel flush_level;       // and immediately after lines at this level
+  LogDurability durability;
+  size_t rotate_bytes;          // rotate before the file grows past this
+  unsigned rotate_interval_sec; // or once it is this old (0 disables)
+  unsigned max_segments;        // closed segments kept (0 keeps all)
+  bool compress;                // gzip closed segments
+} FileLoggerOptions;
+
+#define DEFAULT_FILE_LOGGER_OPTIONS                                            \
+  {.buffer_size = 64 * 1024,                                                   \
+   .flush_interval_ms = 1000,                                                  \
+   .flush_level = LOG_ERROR,                                                   \
+   .durability = LOG_DURABILITY_FLUSH,                                         \
+   .rotate_bytes = 0,                                                          \
+   .rotate_interval_sec = 0,                                                   \
+   .max_segments = 0,                                                          \
+   .compress = false}
+
+Logger make_console_logger(FILE *stream);
+Logger make_file_logger(const char *filename);
+Logger make_file_logger_with_options(const char *filename,
+                                     FileLoggerOptions options);
+Logger make_multi_logger(Logger *targets, size_t count);
+
+// Deferred-formatting target: records a format id, a timestamp and the raw
+// argument bytes; text is reconstructed offline by logdecode.
+Logger make_binary_logger(const char *filename, size_t buffer_size);
+
+// ===== Public Logging API =====
+#if defined(__GNUC__)
+#define LOG_PRINTF(fmt_index)                                                  \
+  __attribute__((format(printf, fmt_index, fmt_index + 1)))
+#define LOG_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define LOG_PRINTF(fmt_index)
+#define LOG_UNLIKELY(x) (x)
+#endif
+
+extern _Atomic LogLevel LOG_CURRENT_LEVEL;
+
+void log_set_level(LogLevel level);
+void log_set_time_format(LogTimeFormat format, LogTimePrecision precision);
+void log_message(Logger *logger, LogLevel level, const char *fmt, ...)
+    LOG_PRINTF(3);
+const char *log_level_name(LogLevel level);
+
+static inline bool log_enabled(LogLevel level) {
+  return level >=
+         atomic_load_explicit(&LOG_CURRENT_LEVEL, memory_order_relaxed);
+}
+
+// ===== Level Macros =====
+// LOG_DEBUG(&logger, fmt, ...) and friends check the runtime level before
+// evaluating their arguments. Levels below LOG_MIN_LEVEL (0 DEBUG .. 3 ERROR,
+// e.g. -DLOG_MIN_LEVEL=2 for release builds) compile to nothing; the dead
+// call is kept only so the format is still type-checked.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+#define LOG_AT(logger, level, ...)                                             \
+  do {                                                                         \
+    if (LOG_UNLIKELY(log_enabled(level)))                                      \
+      log_message((logger), (level), __VA_ARGS__);                             \
+  } while (0)
+
+#define LOG_DISABLED(logger, level, ...)                                       \
+  do {                                                                         \
+    if (0)                                                                     \
+      log_message((logger), (level), __VA_ARGS__);                             \
+  } while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(logger, ...) LOG_AT(logger, LOG_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(logger, ...) LOG_DISABLED(logger, LOG_DEBUG, __VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 1
+#define LOG_INFO(logger, ...) LOG_AT(logger, LOG_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(logger, ...) LOG_DISABLED(logger, LOG_INFO, __VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 2
+#define LOG_WARN(logger, ...) LOG_AT(logger, LOG_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(logger, ...) LOG_DISABLED(logger, LOG_WARN, __VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 3
+#define LOG_ERROR(logger, ...) LOG_AT(logger, LOG_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(logger, ...) LOG_DISABLED(logger, LOG_ERROR, __VA_ARGS__)
+#endif
+
+// ===== Structured Logging =====
+// Typed key/value fields encoded as one JSON object or logfmt line per call,
+// with "ts", "level" and "msg" first:
+//   LOG_FIELDS(&logger, LOG_INFO, "request done", LOG_STR("path", path),
+//              LOG_INT("status", 200), LOG_DOUBLE("ms", 1.5));
+typedef enum { LOG_ENCODING_JSON, LOG_ENCODING_LOGFMT } LogEncoding;
+
+typedef enum {
+  LOG_FIELD_INT,
+  LOG_FIELD_DOUBLE,
+  LOG_FIELD_STRING, // len SIZE_MAX means NUL-terminated
+  LOG_FIELD_BYTES   // encoded as hex
+} LogFieldType;
+
+typedef struct {
+  const char *key;
+  LogFieldType type;
+  union {
+    int64_t i;
+    double d;
+    struct {
+      const char *ptr;
+      size_t len;
+    } s;
+  };
+} LogField;
+
+#define LOG_INT(k, v) ((LogField){.key = (k), .type = LOG_FIELD_INT, .i = (v)})
+#define LOG_DOUBLE(k, v)                                                       \
+  ((LogField){.key = (k), .type = LOG_FIELD_DOUBLE, .d = (v)})
+#define LOG_STR(k, v)                                                          \
+  ((LogField){.key = (k), .type = LOG_FIELD_STRING, .s = {(v), SIZE_MAX}})
+#define LOG_STRN(k, v, n)                                                      \
+  ((LogField){.key = (k), .type = LOG_FIELD_STRING, .s = {(v), (n)}})
+#define LOG_BYTES(k, p, n)                                                     \
+  ((LogField){.key = (k),                                                      \
+              .type = LOG_FIELD_BYTES,                                         \
+              .s = {(const char *)(p), (n)}})
+
+void log_set_field_encoding(LogEncoding encoding);
+void log_fields(Logger *logger, LogLevel level, const char *msg,
+                const LogField *fields, size_t count);
+
+// Checks the level before any field expression is evaluated.
+#define LOG_FIELDS(logger, level, msg, ...)                                    \
+  do {                                                                         \
+    if (LOG_UNLIKELY(log_enabled(level))) {                                    \
+      const LogField log_fields_[] = {__VA_ARGS__};                            \
+      log_fields((logger), (level), (msg), log_fields_,                        \
+                 sizeof(log_fields_) / sizeof(log_fields_[0]));                \
+    }                                                                          \
+  } while (0)
+
+// ===== Rate Limiting and Sampling =====
+// Per-call-site state; the macros below keep one static LogSite per site.
+// Dropped messages are counted and reported as "suppressed N messages" at
+// most once per LOG_SUMMARY_INTERVAL_NS, on the next message that passes.
+typedef struct {
+  _Atomic uint64_t tat;        // token bucket as GCRA: theoretical arrival, ns
+  _Atomic uint64_t calls;      // for 1-in-N sampling
+  _Atomic uint64_t suppressed; // dropped since the last summary
+  _Atomic uint64_t summary_at; // when the last summary was emitted, ns
+} LogSite;
+
+#define LOG_SUMMARY_INTERVAL_NS 1000000000ull
+
+// At most `rate` messages per second, with bursts of up to `burst`.
+bool log_site_allow(LogSite *site, double rate, unsigned burst);
+// Every n-th message.
+bool log_site_sample(LogSite *site, unsigned n);
+void log_site_summary(Logger *logger, LogLevel level, LogSite *site,
+                      const char *file, int line);
+
+#define LOG_RATELIMITED(logger, level, rate, burst, ...)                       \
+  do {                                                                         \
+    static LogSite log_site_;                                                  \
+    if (LOG_UNLIKELY(log_enabled(level)) &&                                    \
+        log_site_allow(&log_site_, (rate), (burst))) {                         \
+      log_site_summary((logger), (level), &log_site_, __FILE__, __LINE__);     \
+      log_message((logger), (level), __VA_ARGS__);                             \
+    }                                                                          \
+  } while (0)
+
+#define LOG_SAMPLED(logger, level, n, ...)                                     \
+  do {                                                                         \
+    static LogSite log_site_;                                                  \
+    if (LOG_UNLIKELY(log_enabled(level)) &&                                    \
+        log_site_sample(&log_site_, (n))) {                                    \
+      log_site_summary((logger), (level), &log_site_, __FILE__, __LINE__);     \
+      log_message((logger), (level), __VA_ARGS__);                             \
+    }                                                                          \
+  } while (0)
+
+// ===== Batch Submission =====
+// Pre-formatted messages handed over in one call, e.g. from Dart FFI. Each
+// message gets the usual timestamp and level prefix.
+typedef struct {
+  int32_t level;
+  uint32_t length;
+  const char *message; // not NUL-terminated
+} LogRecord;
+
+void log_submit_batch(Logger *logger, const LogRecord *records, size_t count);
+
+// Heap-allocated loggers for callers that cannot hold a Logger by value.
+// Unlike make_*, these return NULL with errno set on failure (a bad path,
+// EACCES) instead of exiting, since the caller may be a host runtime.
+Logger *logger_open_console(void);
+Logger *logger_open_file(const char *filename);
+void logger_close(Logger *logger);
+
+// Registers a format string for the binary target and returns its id.
+// Formats are keyed by pointer, so pass the same literal used at the call
+// site; unregistered formats are registered on first use.
+uint16_t log_register_format(const char *fmt);
+
+// ===== Binary Log Format =====
+// File: LOG_BIN_MAGIC, then records. A LOG_REC_FORMAT record (payload: the
+// format text) precedes the first LOG_REC_MESSAGE using its id.
+#define LOG_BIN_MAGIC "NLOGBIN1"
+#define LOG_BIN_MAGIC_LEN 8
+#define LOG_MAX_FORMATS 4096
+#define LOG_MAX_ARGS 32
+
+enum { LOG_REC_FORMAT = 'F', LOG_REC_MESSAGE = 'M' };
+
+typedef struct {
+  uint8_t type;
+  uint8_t level;
+  uint16_t id;
+  uint32_t size;    // payload bytes following the header
+  uint64_t time_ns; // CLOCK_REALTIME
+} LogBinRecord;
+
+// Argument encodings in a message payload, in format order. Integers wider
+// than int and pointers take 8 bytes; strings are a uint16_t length + bytes.
+typedef enum {
+  LOG_ARG_INT,
+  LOG_ARG_LONG,
+  LOG_ARG_LLONG,
+  LOG_ARG_SIZE,
+  LOG_ARG_INTMAX,
+  LOG_ARG_PTRDIFF,
+  LOG_ARG_DOUBLE,
+  LOG_ARG_LDOUBLE,
+  LOG_ARG_STRING,
+  LOG_ARG_POINTER
+} LogArgKind;
+
+// Fills kinds with the va_arg types consumed by fmt; returns the count or
+// -1 if fmt has more than max arguments or an unsupported conversion.
+int log_format_arg_kinds(const char *fmt, uint8_t *kinds, size_t max);
+
+#endif
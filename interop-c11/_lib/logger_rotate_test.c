@@ -0,0 +1,87 @@
+// Rotation under load: producers rotate far faster than gzip keeps up, so
+// the rotator's queue of closed segments overflows. Every segment must
+// still end up compressed, and only max_segments may remain.
+//
+//   cc -std=c11 -pthread -o /tmp/rotate_test logger_rotate_test.c logger.c
+//   /tmp/rotate_test
+#define _GNU_SOURCE
+#include "logger.h"
+#include <dirent.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define THREADS 8
+#define MESSAGES 20000
+#define MAX_SEGMENTS 5
+
+static void *produce(void *arg) {
+  Logger *logger = arg;
+  for (int i = 0; i < MESSAGES; i++)
+    log_message(logger, LOG_INFO, "rotate seq=%d %064d", i, 0);
+  return NULL;
+}
+
+int main(void) {
+  char dir[] = "/tmp/logger_rotate_XXXXXX";
+  if (!mkdtemp(dir)) {
+    perror("mkdtemp");
+    return 1;
+  }
+  char path[256];
+  snprintf(path, sizeof(path), "%s/app.log", dir);
+
+  FileLoggerOptions options = DEFAULT_FILE_LOGGER_OPTIONS;
+  options.buffer_size = 4096;
+  options.rotate_bytes = 16 * 1024;
+  options.max_segments = MAX_SEGMENTS;
+  options.compress = true;
+  Logger logger = make_file_logger_with_options(path, options);
+  pthread_t tids[THREADS];
+  for (int i = 0; i < THREADS; i++)
+    pthread_create(&tids[i], NULL, produce, &logger);
+  for (int i = 0; i < THREADS; i++)
+    pthread_join(tids[i], NULL);
+  logger.close(&logger);
+
+  int failures = 0, segments = 0;
+  unsigned last = 0;
+  DIR *d = opendir(dir);
+  for (struct dirent *e; d && (e = readdir(d));) {
+    if (e->d_name[0] == '.')
+      continue;
+    if (strncmp(e->d_name, "app.log.", 8) == 0) {
+      char *end;
+      unsigned long n = strtoul(e->d_name + 8, &end, 10);
+      if (end == e->d_name + 8 || strcmp(end, ".gz") != 0) {
+        fprintf(stderr, "FAIL: %s is not a compressed segment\n", e->d_name);
+        failures++;
+      }
+      if (n > last)
+        last = (unsigned)n;
+      segments++;
+    }
+    char file[512];
+    snprintf(file, sizeof(file), "%s/%s", dir, e->d_name);
+    unlink(file);
+  }
+  if (d)
+    closedir(d);
+  rmdir(dir);
+
+  // Enough rotations to overflow the queue many times over.
+  if (last < 4 * MAX_SEGMENTS + 8) {
+    fprintf(stderr, "FAIL: only %u rotations\n", last);
+    failures++;
+  }
+  if (segments != MAX_SEGMENTS) {
+    fprintf(stderr, "FAIL: %d segments kept, want %d\n", segments,
+            MAX_SEGMENTS);
+    failures++;
+  }
+  printf("%s: %u rotations, %d segments kept\n", failures ? "FAIL" : "ok",
+         last, segments);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,1190 @@
+// nob_build.h — incremental per-TU builds for the interop-c11 nob scripts
+//
+// Include after nob.h (compiled with NOB_IMPLEMENTATION) in a project's
+// nob.c:
+//
+//   Build b = {.output = "app"};
+//   if (!build_parse_args(&b, argc, argv)) return 1;
+//   build_add_dir_sources(&b, "src");
+//   nob_cmd_append(&b.cflags, "-Wall", "-Wextra", "-std=c11");
+//   nob_cmd_append(&b.ldflags, "-lm");
+//   if (!build_run(&b)) return 1;
+//
+// `./nob [release|debug|native|pgo]` picks a profile; each one builds into
+// build/<profile>/, so switching profiles never recompiles the others.
+// `--unity` compiles all sources as one TU (into build/<profile>-unity/),
+// and `--pch` precompiles the header named by Build.pch once and shares it.
+// `./nob watch [--run]` stays up and rebuilds on every save; see Watch.
+// Every source compiles to <build_dir>/obj/<name>.o with -MMD, and the .d
+// file is read back next time. A TU is recompiled when its source, any
+// header it included, or its compile command changed. Compiles run in
+// parallel, then the link runs if any object is newer than the output.
+// Objects are shared between trees through a content-addressed cache, and
+// every command is timed into <build_dir>/trace.json; see the sections
+// below.
+#ifndef NOB_BUILD_H
+#define NOB_BUILD_H
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#endif
+
+// Like NOBDEF: static inline keeps unused entry points warning-free.
+#ifndef BUILDDEF
+#define BUILDDEF static inline
+#endif
+
+typedef enum {
+  BUILD_RELEASE, // -O2 with LTO
+  BUILD_DEBUG,   // -O0 -g
+  BUILD_NATIVE,  // -O3 -march=native with LTO, for this machine only
+  BUILD_PGO,     // release, optimized with a profile from Build.train
+  BUILD_PROFILE_COUNT,
+} Build_Profile;
+
+static const char *build_profile_names[BUILD_PROFILE_COUNT] = {
+    [BUILD_RELEASE] = "release",
+    [BUILD_DEBUG] = "debug",
+    [BUILD_NATIVE] = "native",
+    [BUILD_PGO] = "pgo",
+};
+
+typedef struct {
+  const char *cc;        // "cc" when NULL
+  const char *build_dir; // "build/<profile>" when NULL; objects in ./obj
+  const char *output;    // executable or shared library, in build_dir
+  Nob_File_Paths sources;
+  Nob_Cmd cflags;  // compile flags, also passed to the link
+  Nob_Cmd ldflags; // link only, after the objects
+  size_t jobs;     // parallel compiles; $NOB_JOBS or nob_nprocs() when 0
+  Build_Profile profile;
+  Nob_Cmd train;   // pgo: arguments for the training run of the output
+  const char *pch; // header that --pch precompiles, e.g. raylib.h
+  bool use_pch;    // --pch; see build__pch
+  bool unity;      // --unity: compile all sources as one TU
+  bool watch;      // watch: rebuild on every change until interrupted
+  bool run;        // --run: watch also (re)starts the output
+  char **argv;     // from build_parse_args; watch re-executes nob with it
+  Nob_File_Paths source_dirs; // from build_add_dir_sources
+} Build;
+
+static void build__defaults(Build *b) {
+  if (!b->cc)
+    b->cc = "cc";
+  if (!b->build_dir)
+    b->build_dir = nob_temp_sprintf("build/%s%s",
+                                    build_profile_names[b->profile],
+                                    b->unity ? "-unity" : "");
+}
+
+// Reads the profile and options from the command line. False (after
+// printing usage) on anything else.
+BUILDDEF bool build_parse_args(Build *b, int argc, char **argv) {
+  b->argv = argv;
+  const char *program = nob_shift(argv, argc);
+  while (argc > 0) {
+    const char *arg = nob_shift(argv, argc);
+    if (strcmp(arg, "watch") == 0) {
+      b->watch = true;
+      continue;
+    }
+    if (strcmp(arg, "--run") == 0) {
+      b->run = true;
+      continue;
+    }
+    if (strcmp(arg, "--unity") == 0) {
+      b->unity = true;
+      continue;
+    }
+    if (strcmp(arg, "--pch") == 0) {
+      b->use_pch = true;
+      continue;
+    }
+    size_t i = 0;
+    while (i < BUILD_PROFILE_COUNT && strcmp(arg, build_profile_names[i]))
+      ++i;
+    if (i == BUILD_PROFILE_COUNT) {
+      nob_log(NOB_ERROR, "usage: %s [release|debug|native|pgo] [--unity] "
+              "[--pch] [watch [--run]]", program);
+      return false;
+    }
+    b->profile = (Build_Profile)i;
+  }
+  return true;
+}
+
+// Where build_run puts the output, e.g. "build/release/app".
+BUILDDEF const char *build_output_path(Build *b) {
+  build__defaults(b);
+  return nob_temp_sprintf("%s/%s", b->build_dir, b->output);
+}
+
+// Points the symlink at path to the output of the profile just built, for
+// consumers that load a fixed path, e.g. build/liblogger.so for Dart.
+BUILDDEF bool build_link_output(Build *b, const char *path) {
+  const char *output = build_output_path(b);
+  const char *slash = strrchr(path, '/');
+  size_t dir_len = slash ? (size_t)(slash - path) + 1 : 0;
+  // Relative when the output is below the link's directory, so the tree
+  // can move.
+  const char *target = strncmp(output, path, dir_len) == 0
+                           ? output + dir_len
+                           : realpath(output, NULL);
+  if (!target) {
+    nob_log(NOB_ERROR, "could not resolve %s: %s", output, strerror(errno));
+    return false;
+  }
+  bool ok = (unlink(path) == 0 || errno == ENOENT) &&
+            symlink(target, path) == 0;
+  if (!ok)
+    nob_log(NOB_ERROR, "could not link %s to %s: %s", path, target,
+            strerror(errno));
+  if (target != output + dir_len)
+    free((char *)target);
+  return ok;
+}
+
+static int build__compare_paths(const void *a, const void *b) {
+  return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+// Adds every *.c file in dir, sorted so object order is stable.
+BUILDDEF bool build_add_dir_sources(Build *b, const char *dir) {
+  Nob_File_Paths names = {0};
+  if (!nob_read_entire_dir(dir, &names))
+    return false;
+  nob_da_append(&b->source_dirs, dir);
+  qsort(names.items, names.count, sizeof *names.items, build__compare_paths);
+  for (size_t i = 0; i < names.count; ++i)
+    if (nob_sv_end_with(nob_sv_from_cstr(names.items[i]), ".c"))
+      nob_da_append(&b->sources,
+                    nob_temp_sprintf("%s/%s", dir, names.items[i]));
+  nob_da_free(names);
+  return true;
+}
+
+// "src/main.c" -> "<build_dir>/obj/src_main<ext>"; "../" prefixes drop.
+static const char *build__obj_path(const Build *b, const char *src,
+                                   const char *ext) {
+  while (strncmp(src, "../", 3) == 0)
+    src += 3;
+  Nob_String_View stem = nob_sv_from_cstr(src);
+  if (nob_sv_end_with(stem, ".c"))
+    stem.count -= 2;
+  char *name = nob_temp_sprintf("%s/obj/" SV_Fmt "%s", b->build_dir,
+                                SV_Arg(stem), ext);
+  for (char *p = name + strlen(b->build_dir) + 5; *p; ++p)
+    if (*p == '/')
+      *p = '_';
+  return name;
+}
+
+// Reads the prerequisites from a make-style .d file ("obj: src hdr \").
+static bool build__read_deps(const char *dep_path, Nob_File_Paths *deps) {
+  Nob_String_Builder sb = {0};
+  if (!nob_file_exists(dep_path) || !nob_read_entire_file(dep_path, &sb))
+    return false;
+  const char *p = sb.items, *end = sb.items + sb.count;
+  while (p < end && *p != ':')
+    ++p; // skip the target
+  if (p < end)
+    ++p;
+  Nob_String_Builder token = {0};
+  while (p <= end) {
+    bool escaped = p + 1 < end && p[0] == '\\' && p[1] == ' ';
+    if (p == end || ((*p == ' ' || *p == '\n' || *p == '\t' ||
+                      (*p == '\\' && p + 1 < end && p[1] == '\n')) &&
+                     !escaped)) {
+      if (token.count > 0) {
+        nob_sb_append_null(&token);
+        nob_da_append(deps, nob_temp_strdup(token.items));
+        token.count = 0;
+      }
+      if (p < end && *p == '\\')
+        ++p; // line continuation
+    } else {
+      if (escaped)
+        ++p;
+      nob_da_append(&token, *p);
+    }
+    ++p;
+  }
+  nob_sb_free(token);
+  nob_sb_free(sb);
+  return true;
+}
+
+// nob_needs_rebuild with nanosecond mtimes: an edit in the same second as
+// the last compile still counts. 1 = stale, 0 = current, -1 = input gone.
+static int build__needs_rebuild(const char *output, const char **inputs,
+                                size_t count) {
+  struct stat out, in;
+  if (stat(output, &out) < 0)
+    return 1;
+  for (size_t i = 0; i < count; ++i) {
+    if (stat(inputs[i], &in) < 0)
+      return -1;
+    if (in.st_mtim.tv_sec > out.st_mtim.tv_sec ||
+        (in.st_mtim.tv_sec == out.st_mtim.tv_sec &&
+         in.st_mtim.tv_nsec > out.st_mtim.tv_nsec))
+      return 1;
+  }
+  return 0;
+}
+
+// Compares cmd with the one stored at path. Stores it when they differ.
+static bool build__command_changed(const char *path, Nob_Cmd cmd) {
+  Nob_String_Builder now = {0}, before = {0};
+  nob_cmd_render(cmd, &now);
+  bool changed = !nob_file_exists(path) ||
+                 !nob_read_entire_file(path, &before) ||
+                 before.count != now.count ||
+                 memcmp(before.items, now.items, now.count) != 0;
+  if (changed)
+    nob_write_entire_file(path, now.items, now.count);
+  nob_sb_free(now);
+  nob_sb_free(before);
+  return changed;
+}
+
+// Whether src must be recompiled into obj with this command.
+static bool build__tu_stale(const char *src, const char *obj,
+                            const char *dep, const char *cmd_path,
+                            Nob_Cmd cmd) {
+  if (build__command_changed(cmd_path, cmd))
+    return true;
+  Nob_File_Paths inputs = {0};
+  if (!build__read_deps(dep, &inputs))
+    nob_da_append(&inputs, src); // first build or lost .d
+  int stale = build__needs_rebuild(obj, inputs.items, inputs.count);
+  nob_da_free(inputs);
+  return stale != 0; // < 0 (a header vanished) also rebuilds
+}
+
+// ===== Trace =====
+//
+// build_run records every command it starts in <build_dir>/trace.json, in
+// Chrome's trace event format (open it in chrome://tracing or
+// ui.perfetto.dev). Lane 0 is nob itself (dependency checks, cache
+// lookups); lanes 1..jobs are the process slots, so idle slots show up as
+// gaps. Each event carries the command line and exit status as args.
+// Timestamps come from the monotonic clock, which lets the top-level
+// driver merge the project traces into one: it sets NOB_TRACE_PID so each
+// project lands in its own process row.
+
+typedef struct {
+  Nob_String_Builder events; // one per line, each ending in ",\n"
+  int pid;
+} Build_Trace;
+
+static void build__json_string(Nob_String_Builder *sb, const char *s) {
+  nob_da_append(sb, '"');
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\') {
+      nob_da_append(sb, '\\');
+      nob_da_append(sb, *s);
+    } else if ((unsigned char)*s < 0x20) {
+      nob_sb_appendf(sb, "\\u%04x", *s);
+    } else {
+      nob_da_append(sb, *s);
+    }
+  }
+  nob_da_append(sb, '"');
+}
+
+static void build__trace_meta(Build_Trace *t, const char *what, size_t lane,
+                              const char *name) {
+  nob_sb_appendf(&t->events, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%zu,"
+                 "\"name\":\"%s\",\"args\":{\"name\":", t->pid, lane, what);
+  build__json_string(&t->events, name);
+  nob_sb_appendf(&t->events, "}},\n");
+}
+
+// Names the process row and its lanes: 0 is "nob", 1..slots are "slot N".
+BUILDDEF void build_trace_begin(Build_Trace *t, const char *process,
+                                size_t slots) {
+  const char *pid = getenv("NOB_TRACE_PID");
+  t->pid = pid ? atoi(pid) : 0;
+  build__trace_meta(t, "process_name", 0, process);
+  build__trace_meta(t, "thread_name", 0, "nob");
+  for (size_t i = 1; i <= slots; ++i)
+    build__trace_meta(t, "thread_name", i, nob_temp_sprintf("slot %zu", i));
+}
+
+// A complete event on lane. cmd may be NULL for work nob does itself.
+BUILDDEF void build_trace_event(Build_Trace *t, const char *cat,
+                                const char *name, size_t lane,
+                                uint64_t start_ns, uint64_t end_ns,
+                                const char *cmd, int status) {
+  nob_sb_appendf(&t->events, "{\"ph\":\"X\",\"pid\":%d,\"tid\":%zu,"
+                 "\"ts\":%.3f,\"dur\":%.3f,\"cat\":\"%s\",\"name\":", t->pid,
+                 lane, start_ns / 1e3, (end_ns - start_ns) / 1e3, cat);
+  build__json_string(&t->events, name);
+  if (cmd) {
+    nob_sb_appendf(&t->events, ",\"args\":{\"cmd\":");
+    build__json_string(&t->events, cmd);
+    nob_sb_appendf(&t->events, ",\"status\":%d}", status);
+  }
+  nob_sb_appendf(&t->events, "},\n");
+}
+
+// Appends the events of a trace written by build_trace_write.
+BUILDDEF bool build_trace_include(Build_Trace *t, const char *path) {
+  Nob_String_Builder sb = {0};
+  if (!nob_file_exists(path) || !nob_read_entire_file(path, &sb))
+    return false;
+  Nob_String_View content = nob_sb_to_sv(sb);
+  while (content.count > 0) {
+    Nob_String_View line = nob_sv_chop_by_delim(&content, '\n');
+    if (!nob_sv_starts_with(line, nob_sv_from_cstr("{\"ph\"")))
+      continue;
+    if (nob_sv_end_with(line, ","))
+      line.count--;
+    nob_sb_append_buf(&t->events, line.data, line.count);
+    nob_sb_append_cstr(&t->events, ",\n");
+  }
+  nob_sb_free(sb);
+  return true;
+}
+
+BUILDDEF bool build_trace_write(Build_Trace *t, const char *path) {
+  Nob_String_Builder sb = {0};
+  nob_sb_append_cstr(&sb, "{\"traceEvents\":[\n");
+  nob_sb_append_buf(&sb, t->events.items, t->events.count);
+  if (t->events.count >= 2)
+    sb.count -= 2; // the last ",\n"
+  nob_sb_append_cstr(&sb, "\n]}\n");
+  bool ok = nob_write_entire_file(path, sb.items, sb.count);
+  nob_sb_free(sb);
+  return ok;
+}
+
+// ===== Processes =====
+//
+// Runs commands in a fixed number of slots, like nob_cmd_run with .async,
+// but reaps each process as it exits so it can be traced on its slot.
+
+typedef struct {
+  Nob_Proc proc;
+  const char *cat;
+  const char *name;
+  Nob_String_Builder cmd;
+  uint64_t start_ns;
+} Build_Slot;
+
+typedef struct {
+  Build_Slot *slots;
+  size_t jobs;
+  size_t running;
+  size_t failed;
+  Nob_Procs spawned;
+  Build_Trace *trace;
+  Nob_Proc app; // watch --run: the output, if it is running
+} Build_Pool;
+
+static void build__pool_reap(Build_Pool *pool) {
+  int status = 0;
+  pid_t pid = waitpid(-1, &status, 0);
+  if (pid < 0) {
+    nob_log(NOB_ERROR, "could not wait on commands: %s", strerror(errno));
+    pool->failed += pool->running;
+    for (size_t i = 0; i < pool->jobs; ++i)
+      pool->slots[i].proc = NOB_INVALID_PROC;
+    pool->running = 0;
+    return;
+  }
+  for (size_t i = 0; i < pool->jobs; ++i) {
+    Build_Slot *slot = &pool->slots[i];
+    if (slot->proc != pid)
+      continue;
+    int code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    if (code != 0) {
+      nob_log(NOB_ERROR, "command exited with exit code %d", code);
+      pool->failed++;
+    }
+    nob_sb_append_null(&slot->cmd);
+    build_trace_event(pool->trace, slot->cat, slot->name, i + 1,
+                      slot->start_ns, nob_nanos_since_unspecified_epoch(),
+                      slot->cmd.items, code);
+    slot->proc = NOB_INVALID_PROC;
+    pool->running--;
+    return;
+  }
+  if (pid == pool->app)
+    pool->app = NOB_INVALID_PROC; // exited on its own during a build
+}
+
+static void build__pool_init(Build_Pool *pool, size_t jobs,
+                             Build_Trace *trace) {
+  *pool = (Build_Pool){
+      .jobs = jobs, .trace = trace, .app = NOB_INVALID_PROC};
+  pool->slots = NOB_REALLOC(NULL, jobs * sizeof(Build_Slot));
+  NOB_ASSERT(pool->slots != NULL && "Buy more RAM lol");
+  for (size_t i = 0; i < jobs; ++i)
+    pool->slots[i] = (Build_Slot){.proc = NOB_INVALID_PROC};
+}
+
+static void build__pool_free(Build_Pool *pool) {
+  for (size_t i = 0; i < pool->jobs; ++i)
+    nob_sb_free(pool->slots[i].cmd);
+  NOB_FREE(pool->slots);
+  nob_da_free(pool->spawned);
+}
+
+// Starts cmd in a free slot, waiting for one if all are busy. Resets cmd.
+static bool build__pool_start(Build_Pool *pool, Nob_Cmd *cmd, const char *cat,
+                              const char *name, const char *stdout_path) {
+  while (pool->running >= pool->jobs)
+    build__pool_reap(pool);
+  Build_Slot *slot = pool->slots;
+  while (slot->proc != NOB_INVALID_PROC)
+    ++slot;
+  slot->cat = cat;
+  slot->name = name;
+  slot->cmd.count = 0;
+  nob_cmd_render(*cmd, &slot->cmd);
+  slot->start_ns = nob_nanos_since_unspecified_epoch();
+  if (!nob_cmd_run(cmd, .async = &pool->spawned, .stdout_path = stdout_path)) {
+    pool->failed++;
+    return false;
+  }
+  slot->proc = pool->spawned.items[--pool->spawned.count];
+  pool->running++;
+  return true;
+}
+
+// Waits for every running command. False if any command so far failed.
+static bool build__pool_flush(Build_Pool *pool) {
+  while (pool->running > 0)
+    build__pool_reap(pool);
+  return pool->failed == 0;
+}
+
+// ===== Object cache =====
+//
+// Objects are also stored under ~/.cache/nob (or $XDG_CACHE_HOME/nob),
+// keyed on a hash of the preprocessed source, the compiler's --version
+// output and the compile flags. A stale TU is preprocessed first and its
+// object copied from the cache when the key is known, so a clean build or
+// a branch switch only compiles what was never compiled before. Set
+// NOB_CACHE_DIR to move the cache, or to an empty string to disable it.
+
+typedef struct {
+  const char *src;
+  const char *obj;
+  const char *dep;
+  const char *cached; // cache entry for this TU, NULL if not looked up
+  bool hit;
+} Build_Tu;
+
+typedef struct {
+  Build_Tu *items;
+  size_t count;
+  size_t capacity;
+} Build_Tus;
+
+static const char *build__cache_dir(void) {
+  const char *dir = getenv("NOB_CACHE_DIR");
+  if (dir)
+    return *dir ? dir : NULL;
+  if ((dir = getenv("XDG_CACHE_HOME")) && *dir)
+    return nob_temp_sprintf("%s/nob", dir);
+  if ((dir = getenv("HOME")) && *dir)
+    return nob_temp_sprintf("%s/.cache/nob", dir);
+  return NULL;
+}
+
+// mkdir -p without nob_mkdir_if_not_exists's logging.
+static bool build__mkdirs(const char *path) {
+  char *p = nob_temp_strdup(path);
+  for (char *s = p + 1; *s; ++s) {
+    if (*s != '/')
+      continue;
+    *s = '\0';
+    if (mkdir(p, 0755) < 0 && errno != EEXIST)
+      return false;
+    *s = '/';
+  }
+  return mkdir(p, 0755) == 0 || errno == EEXIST;
+}
+
+// FNV-1a, 128-bit.
+typedef unsigned __int128 Build_Hash;
+
+static Build_Hash build__hash(Build_Hash h, const void *data, size_t size) {
+  const Build_Hash prime = ((Build_Hash)1 << 88) | 0x13b;
+  const unsigned char *p = data;
+  for (size_t i = 0; i < size; ++i)
+    h = (h ^ p[i]) * prime;
+  return h;
+}
+
+static Build_Hash build__hash_init(void) {
+  return ((Build_Hash)0x6c62272e07bb0142ULL << 64) | 0x62b821756295c58dULL;
+}
+
+// Copies via a temporary name so readers never see a partial object.
+static bool build__copy(const char *from, const char *to) {
+  Nob_String_Builder sb = {0};
+  const char *tmp = nob_temp_sprintf("%s.%d.tmp", to, (int)getpid());
+  bool ok = nob_read_entire_file(from, &sb) &&
+            nob_write_entire_file(tmp, sb.items, sb.count) &&
+            rename(tmp, to) == 0;
+  if (!ok)
+    remove(tmp);
+  nob_sb_free(sb);
+  return ok;
+}
+
+// Hash of the compiler's `--version` output and cflags: the part of every
+// cache key that does not depend on the input. `cc --version` runs once per
+// process. Debug info records the directory it was compiled in
+// (DW_AT_comp_dir), so with -g the working directory is part of the key too
+// and another checkout's objects are never restored into this one.
+static bool build__toolchain_hash(Build *b, Nob_Cmd cflags, Build_Pool *pool,
+                                  Build_Hash *out) {
+  static const char *cc;
+  static Nob_String_Builder version;
+  if (!cc || strcmp(cc, b->cc) != 0) {
+    const char *path = build__obj_path(b, "cc", ".version");
+    Nob_Cmd cmd = {0};
+    nob_cmd_append(&cmd, b->cc, "--version");
+    size_t failed = pool->failed;
+    bool ok = build__pool_start(pool, &cmd, "cache", "cc --version", path) &&
+              build__pool_flush(pool);
+    pool->failed = failed;
+    nob_cmd_free(cmd);
+    version.count = 0;
+    if (!ok || !nob_read_entire_file(path, &version))
+      return false;
+    cc = b->cc;
+  }
+  Build_Hash h = build__hash(build__hash_init(), version.items, version.count);
+  bool debug = false;
+  for (size_t i = 0; i < cflags.count; ++i) {
+    const char *flag = cflags.items[i];
+    h = build__hash(h, flag, strlen(flag) + 1);
+    if (strncmp(flag, "-g", 2) == 0)
+      debug = strcmp(flag, "-g0") != 0;
+  }
+  if (debug) {
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof cwd))
+      return false;
+    h = build__hash(h, cwd, strlen(cwd) + 1);
+  }
+  *out = h;
+  return true;
+}
+
+// "<dir>/ab/cdef...<ext>" for a hash.
+static const char *build__hash_path(const char *dir, Build_Hash h,
+                                    const char *ext) {
+  unsigned long long hi = (unsigned long long)(h >> 64);
+  unsigned long long lo = (unsigned long long)h;
+  return nob_temp_sprintf("%s/%02llx/%014llx%016llx%s", dir, hi >> 56,
+                          hi & 0xffffffffffffffULL, lo, ext);
+}
+
+// Preprocesses the stale TUs in parallel and restores every object whose
+// key is already cached. Returns the number of hits.
+static size_t build__cache_fetch(Build *b, Nob_Cmd cflags, Build_Tus *tus,
+                                 const char *dir, Build_Pool *pool) {
+  Build_Hash base;
+  if (!build__mkdirs(dir) || !build__toolchain_hash(b, cflags, pool, &base))
+    return 0;
+  Nob_Cmd cmd = {0};
+  size_t failed = pool->failed;
+
+  // -MMD here writes the same .d a compile would, so hits keep their deps.
+  for (size_t i = 0; i < tus->count; ++i) {
+    Build_Tu *tu = &tus->items[i];
+    nob_cmd_append(&cmd, b->cc);
+    nob_da_append_many(&cmd, cflags.items, cflags.count);
+    nob_cmd_append(&cmd, "-MMD", "-MF", tu->dep, "-E", tu->src, "-o",
+                   build__obj_path(b, tu->src, ".i"));
+    build__pool_start(pool, &cmd, "preprocess", tu->src, NULL);
+  }
+  // On failure the compile reports the error; nothing is looked up.
+  bool ok = build__pool_flush(pool);
+  pool->failed = failed;
+
+  uint64_t start = nob_nanos_since_unspecified_epoch();
+  size_t hits = 0;
+  Nob_String_Builder sb = {0};
+  for (size_t i = 0; i < tus->count; ++i) {
+    Build_Tu *tu = &tus->items[i];
+    const char *pre = build__obj_path(b, tu->src, ".i");
+    // With -fprofile-use the object also depends on the profile data.
+    const char *gcda = build__obj_path(b, tu->src, ".gcda");
+    sb.count = 0;
+    if (ok && nob_read_entire_file(pre, &sb) &&
+        (!nob_file_exists(gcda) || nob_read_entire_file(gcda, &sb))) {
+      Build_Hash h = build__hash(base, sb.items, sb.count);
+      tu->cached = build__hash_path(dir, h, ".o");
+      tu->hit = nob_file_exists(tu->cached) &&
+                build__copy(tu->cached, tu->obj);
+      hits += tu->hit;
+    }
+    remove(pre);
+  }
+  build_trace_event(pool->trace, "cache", "cache lookup", 0, start,
+                    nob_nanos_since_unspecified_epoch(), NULL, 0);
+  nob_sb_free(sb);
+  nob_cmd_free(cmd);
+  return hits;
+}
+
+// Stores the objects that were compiled after a miss.
+static void build__cache_store(Build_Tus *tus) {
+  for (size_t i = 0; i < tus->count; ++i) {
+    Build_Tu *tu = &tus->items[i];
+    if (!tu->cached || tu->hit || !nob_file_exists(tu->obj))
+      continue;
+    const char *sub = nob_temp_strdup(tu->cached);
+    *strrchr((char *)sub, '/') = '\0';
+    if (build__mkdirs(sub))
+      build__copy(tu->obj, tu->cached);
+  }
+}
+
+// ===== Precompiled header and unity builds =====
+
+// Precompiles b->pch and returns the directory holding "<name>.gch", to go
+// first on the include path: gcc checks each include directory for a .gch
+// before the header itself, so every TU whose first include is the header
+// uses it, and any other TU parses the header as before. The .gch is keyed
+// on the toolchain, the flags and the header's bytes and lives in the
+// object cache, so it is built once and shared by every project (and
+// profile) with the same key.
+static const char *build__pch(Build *b, Nob_Cmd cflags, Build_Pool *pool) {
+  Build_Hash h;
+  Nob_String_Builder header = {0};
+  if (!build__toolchain_hash(b, cflags, pool, &h) ||
+      !nob_read_entire_file(b->pch, &header))
+    return NULL;
+  h = build__hash(h, header.items, header.count);
+  nob_sb_free(header);
+
+  const char *cache = build__cache_dir();
+  const char *dir = build__hash_path(
+      cache ? cache : nob_temp_sprintf("%s/pch", b->build_dir), h, "");
+  const char *name = strrchr(b->pch, '/') ? strrchr(b->pch, '/') + 1 : b->pch;
+  const char *gch = nob_temp_sprintf("%s/%s.gch", dir, name);
+  if (nob_file_exists(gch))
+    return dir;
+
+  const char *tmp = nob_temp_sprintf("%s.%d.tmp", gch, (int)getpid());
+  Nob_Cmd cmd = {0};
+  nob_cmd_append(&cmd, b->cc);
+  nob_da_append_many(&cmd, cflags.items, cflags.count);
+  nob_cmd_append(&cmd, "-x", "c-header", b->pch, "-o", tmp);
+  size_t failed = pool->failed;
+  bool ok = build__mkdirs(dir) &&
+            build__pool_start(pool, &cmd, "pch", name, NULL) &&
+            build__pool_flush(pool) && rename(tmp, gch) == 0;
+  nob_cmd_free(cmd);
+  if (!ok) {
+    remove(tmp);
+    nob_log(NOB_WARNING, "could not precompile %s; parsing it per TU",
+            b->pch);
+    pool->failed = failed;
+    return NULL;
+  }
+  return dir;
+}
+
+// Writes <build_dir>/unity.c, which includes every source. It is rewritten
+// only when the source list changes, so its .d keeps incremental rebuilds
+// (of the whole unit) working.
+static const char *build__unity_source(Build *b) {
+  Nob_String_Builder sb = {0};
+  for (size_t i = 0; i < b->sources.count; ++i) {
+    char *path = realpath(b->sources.items[i], NULL);
+    if (!path) {
+      nob_log(NOB_ERROR, "%s: %s", b->sources.items[i], strerror(errno));
+      nob_sb_free(sb);
+      return NULL;
+    }
+    nob_sb_appendf(&sb, "#include \"%s\"\n", path);
+    free(path);
+  }
+  const char *unity = nob_temp_sprintf("%s/unity.c", b->build_dir);
+  Nob_String_Builder old = {0};
+  bool same = nob_file_exists(unity) && nob_read_entire_file(unity, &old) &&
+              old.count == sb.count &&
+              memcmp(old.items, sb.items, sb.count) == 0;
+  bool ok = same || nob_write_entire_file(unity, sb.items, sb.count);
+  nob_sb_free(old);
+  nob_sb_free(sb);
+  return ok ? unity : NULL;
+}
+
+// ===== Build =====
+
+// Compiles the stale TUs with cflags and links the output.
+// dirty, when not NULL, says which sources changed (see Watch); the rest
+// are taken as current without looking at the disk.
+static bool build__compile(Build *b, Nob_Cmd cflags, Build_Pool *pool,
+                           const bool *dirty) {
+  const char *output = build_output_path(b);
+  if (!build__mkdirs(nob_temp_sprintf("%s/obj", b->build_dir)))
+    return false;
+
+  uint64_t begin = nob_nanos_since_unspecified_epoch();
+  uint64_t start = begin;
+  Nob_File_Paths objects = {0};
+  Build_Tus stale = {0};
+  Nob_Cmd cmd = {0};
+  for (size_t i = 0; i < b->sources.count; ++i) {
+    Build_Tu tu = {.src = b->sources.items[i]};
+    tu.obj = build__obj_path(b, tu.src, ".o");
+    tu.dep = build__obj_path(b, tu.src, ".d");
+    nob_da_append(&objects, tu.obj);
+    if (dirty && !dirty[i])
+      continue;
+
+    nob_cmd_append(&cmd, b->cc);
+    nob_da_append_many(&cmd, cflags.items, cflags.count);
+    nob_cmd_append(&cmd, "-MMD", "-MF", tu.dep, "-c", tu.src, "-o", tu.obj);
+    // A dirty TU compiles even when its object looks newer: the edit may
+    // have landed while the last compile of it was still running.
+    bool is_stale = build__tu_stale(tu.src, tu.obj, tu.dep,
+                                    build__obj_path(b, tu.src, ".cmd"),
+                                    cmd) ||
+                    dirty;
+    cmd.count = 0;
+    if (!is_stale)
+      continue;
+    // A failed compile must not leave an older object looking current.
+    if (nob_file_exists(tu.obj))
+      nob_delete_file(tu.obj);
+    nob_da_append(&stale, tu);
+  }
+  build_trace_event(pool->trace, "deps", "dependency scan", 0, start,
+                    nob_nanos_since_unspecified_epoch(), NULL, 0);
+
+  const char *cache = build__cache_dir();
+  size_t hits = 0;
+  if (cache && stale.count > 0)
+    hits = build__cache_fetch(b, cflags, &stale, cache, pool);
+
+  for (size_t i = 0; i < stale.count && pool->failed == 0; ++i) {
+    Build_Tu *tu = &stale.items[i];
+    if (tu->hit)
+      continue;
+    nob_cmd_append(&cmd, b->cc);
+    nob_da_append_many(&cmd, cflags.items, cflags.count);
+    nob_cmd_append(&cmd, "-MMD", "-MF", tu->dep, "-c", tu->src, "-o",
+                   tu->obj);
+    build__pool_start(pool, &cmd, "compile", tu->src, NULL);
+  }
+  bool ok = build__pool_flush(pool);
+  if (cache) {
+    start = nob_nanos_since_unspecified_epoch();
+    build__cache_store(&stale);
+    build_trace_event(pool->trace, "cache", "cache store", 0, start,
+                      nob_nanos_since_unspecified_epoch(), NULL, 0);
+  }
+
+  if (ok) {
+    nob_cmd_append(&cmd, b->cc);
+    nob_da_append_many(&cmd, cflags.items, cflags.count);
+    nob_da_append_many(&cmd, objects.items, objects.count);
+    nob_cmd_append(&cmd, "-o", output);
+    nob_da_append_many(&cmd, b->ldflags.items, b->ldflags.count);
+    const char *link_cmd = nob_temp_sprintf("%s.cmd", output);
+    if (build__command_changed(link_cmd, cmd) ||
+        build__needs_rebuild(output, objects.items, objects.count) != 0)
+      ok = build__pool_start(pool, &cmd, "link", output, NULL) &&
+           build__pool_flush(pool);
+    cmd.count = 0;
+  }
+
+  double secs =
+      (double)(nob_nanos_since_unspecified_epoch() - begin) / NOB_NANOS_PER_SEC;
+  if (ok && cache && stale.count > 0)
+    nob_log(NOB_INFO, "%s: %zu of %zu TUs compiled in %.2fs (cache: %zu "
+            "hits, %zu misses)", output, stale.count - hits,
+            b->sources.count, secs, hits, stale.count - hits);
+  else if (ok)
+    nob_log(NOB_INFO, "%s: %zu of %zu TUs compiled in %.2fs", output,
+            stale.count, b->sources.count, secs);
+  nob_cmd_free(cmd);
+  nob_da_free(stale);
+  nob_da_free(objects);
+  return ok;
+}
+
+// gcc's PGO cycle: build instrumented, run b->train against the output,
+// then rebuild with the profile. Both builds share the object directory
+// because gcc finds each .gcda by the path of the object it belongs to.
+static bool build__pgo(Build *b, Nob_Cmd cflags, Build_Pool *pool) {
+  for (size_t i = 0; i < b->sources.count; ++i)
+    remove(build__obj_path(b, b->sources.items[i], ".gcda"));
+  size_t base = cflags.count;
+  nob_cmd_append(&cflags, "-fprofile-generate", "-fprofile-update=atomic");
+  bool ok = build__compile(b, cflags, pool, NULL);
+
+  if (ok) {
+    Nob_Cmd cmd = {0};
+    const char *output = build_output_path(b);
+    nob_cmd_append(&cmd, nob_temp_sprintf("./%s", output));
+    nob_da_append_many(&cmd, b->train.items, b->train.count);
+    const char *log = nob_temp_sprintf("%s/train.log", b->build_dir);
+    ok = build__pool_start(pool, &cmd, "train", output, log) &&
+         build__pool_flush(pool);
+    nob_cmd_free(cmd);
+  }
+
+  cflags.count = base;
+  nob_cmd_append(&cflags, "-fprofile-use", "-fprofile-partial-training",
+                 "-Wno-missing-profile");
+  ok = ok && build__compile(b, cflags, pool, NULL);
+  nob_cmd_free(cflags);
+  return ok;
+}
+
+// ===== Watch =====
+//
+// `./nob watch` builds, then stays up and rebuilds after every change until
+// interrupted. The inputs of each TU (its .d file, as real paths) stay in
+// memory and inotify watches their directories, so a saved file maps
+// straight to the TUs that use it: nothing is scanned or stat'ed between
+// edits, and a rebuild costs the changed compiles and the link. Events are
+// debounced for BUILD_WATCH_QUIET_MS since editors save with a burst of
+// writes and renames. With --run the output is restarted after each
+// successful build, so edit-to-run takes about one compile.
+//
+// A change to nob.c or this header, or a new .c file in a directory given
+// to build_add_dir_sources, re-executes nob, which rebuilds itself and
+// picks up the new sources.
+
+#ifndef BUILD_WATCH_QUIET_MS
+#define BUILD_WATCH_QUIET_MS 100
+#endif
+
+#ifdef __linux__
+typedef struct {
+  int wd;
+  char *dir; // real path
+} Build_Watch_Dir;
+
+typedef struct {
+  Build_Watch_Dir *items;
+  size_t count;
+  size_t capacity;
+} Build_Watch_Dirs;
+
+typedef struct {
+  int fd; // inotify
+  Build_Watch_Dirs dirs;
+  Nob_File_Paths *inputs;     // per source: real paths of it and its headers
+  Nob_File_Paths self;        // nob.c and nob_build.h
+  Nob_File_Paths source_dirs; // real paths of Build.source_dirs
+  bool *dirty;                // per source, set by build__watch_wait
+} Build_Watch;
+
+static void build__watch_dir(Build_Watch *w, const char *file) {
+  const char *slash = strrchr(file, '/'); // file is a real path
+  const char *dir = "/";
+  if (slash != file)
+    dir = nob_temp_sprintf("%.*s", (int)(slash - file), file);
+  for (size_t i = 0; i < w->dirs.count; ++i)
+    if (strcmp(w->dirs.items[i].dir, dir) == 0)
+      return;
+  int wd = inotify_add_watch(w->fd, dir,
+                             IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE |
+                                 IN_DELETE);
+  if (wd < 0) {
+    nob_log(NOB_WARNING, "could not watch %s: %s", dir, strerror(errno));
+    return;
+  }
+  nob_da_append(&w->dirs, ((Build_Watch_Dir){wd, strdup(dir)}));
+}
+
+// Appends the real path of file to paths and watches its directory.
+static void build__watch_add(Build_Watch *w, Nob_File_Paths *paths,
+                             const char *file) {
+  char *real = realpath(file, NULL);
+  if (!real)
+    return;
+  nob_da_append(paths, real);
+  build__watch_dir(w, real);
+}
+
+// Reloads the inputs of source i from its .d file. Keeps the old ones when
+// there is none, as after a failed compile.
+static void build__watch_inputs(Build_Watch *w, Build *b, size_t i) {
+  Nob_File_Paths deps = {0};
+  const char *src = b->sources.items[i];
+  if (!build__read_deps(build__obj_path(b, src, ".d"), &deps) &&
+      w->inputs[i].count > 0)
+    return;
+  for (size_t j = 0; j < w->inputs[i].count; ++j)
+    free((char *)w->inputs[i].items[j]);
+  w->inputs[i].count = 0;
+  build__watch_add(w, &w->inputs[i], src);
+  for (size_t j = 0; j < deps.count; ++j)
+    build__watch_add(w, &w->inputs[i], deps.items[j]);
+  nob_da_free(deps);
+}
+
+static bool build__watch_has(const Nob_File_Paths *paths, const char *path) {
+  for (size_t i = 0; i < paths->count; ++i)
+    if (strcmp(paths->items[i], path) == 0)
+      return true;
+  return false;
+}
+
+// Blocks until a burst of changes is over. 1 when nob must re-execute,
+// 0 with w->dirty set, -1 on error. *first_ns is when the burst began.
+static int build__watch_wait(Build_Watch *w, Build *b, uint64_t *first_ns) {
+  char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  bool any = false, reexec = false;
+  int timeout = -1;
+  for (;;) {
+    struct pollfd pfd = {.fd = w->fd, .events = POLLIN};
+    int n = poll(&pfd, 1, timeout);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n == 0 && (any || reexec))
+      return reexec;
+    if (n == 0) {
+      timeout = -1; // only unrelated files changed
+      continue;
+    }
+    ssize_t len = n < 0 ? -1 : read(w->fd, buf, sizeof buf);
+    if (len < 0 && errno == EINTR)
+      continue;
+    if (len < 0) {
+      nob_log(NOB_ERROR, "could not watch for changes: %s", strerror(errno));
+      return -1;
+    }
+    if (timeout < 0)
+      *first_ns = nob_nanos_since_unspecified_epoch();
+    timeout = BUILD_WATCH_QUIET_MS;
+
+    size_t mark = nob_temp_save();
+    for (char *p = buf; p < buf + len; nob_temp_rewind(mark)) {
+      const struct inotify_event *ev = (const struct inotify_event *)p;
+      p += sizeof *ev + ev->len;
+      if (ev->mask & IN_Q_OVERFLOW) { // events were lost
+        for (size_t i = 0; i < b->sources.count; ++i)
+          w->dirty[i] = any = true;
+        continue;
+      }
+      const char *dir = NULL;
+      for (size_t i = 0; i < w->dirs.count && !dir; ++i)
+        if (w->dirs.items[i].wd == ev->wd)
+          dir = w->dirs.items[i].dir;
+      if (!dir || ev->len == 0)
+        continue;
+      const char *path = nob_temp_sprintf("%s/%s", dir, ev->name);
+      if (build__watch_has(&w->self, path))
+        reexec = true;
+      bool used = false;
+      for (size_t i = 0; i < b->sources.count; ++i)
+        if (build__watch_has(&w->inputs[i], path))
+          w->dirty[i] = any = used = true;
+      if (!used && (ev->mask & (IN_CREATE | IN_MOVED_TO)) &&
+          nob_sv_end_with(nob_sv_from_cstr(ev->name), ".c") &&
+          build__watch_has(&w->source_dirs, dir))
+        reexec = true;
+    }
+  }
+}
+
+static void build__watch_stop(Build_Pool *pool) {
+  if (pool->app == NOB_INVALID_PROC)
+    return;
+  kill(pool->app, SIGTERM);
+  waitpid(pool->app, NULL, 0);
+  pool->app = NOB_INVALID_PROC;
+}
+
+static void build__watch_start(Build *b, Build_Pool *pool) {
+  build__watch_stop(pool);
+  Nob_Cmd cmd = {0};
+  nob_cmd_append(&cmd, nob_temp_sprintf("./%s", build_output_path(b)));
+  if (nob_cmd_run(&cmd, .async = &pool->spawned))
+    pool->app = pool->spawned.items[--pool->spawned.count];
+  nob_cmd_free(cmd);
+}
+
+static bool build__watch(Build *b, Nob_Cmd cflags, Build_Pool *pool) {
+  Build_Watch w = {.fd = inotify_init1(IN_CLOEXEC)};
+  if (w.fd < 0) {
+    nob_log(NOB_ERROR, "could not start inotify: %s", strerror(errno));
+    return false;
+  }
+  w.inputs = calloc(b->sources.count, sizeof *w.inputs);
+  w.dirty = calloc(b->sources.count, sizeof *w.dirty);
+  NOB_ASSERT(w.inputs && w.dirty && "Buy more RAM lol");
+  build__watch_add(&w, &w.self, "nob.c");
+  build__watch_add(&w, &w.self, __FILE__);
+  for (size_t i = 0; i < b->source_dirs.count; ++i) {
+    char *real = realpath(b->source_dirs.items[i], NULL);
+    if (real)
+      nob_da_append(&w.source_dirs, real);
+  }
+
+  const char *trace_path = nob_temp_sprintf("%s/trace.json", b->build_dir);
+  size_t trace_meta = pool->trace->events.count;
+  size_t mark = nob_temp_save();
+  const bool *dirty = NULL; // the first build checks every TU
+  uint64_t changed_ns = 0;
+  for (;;) {
+    pool->failed = 0;
+    bool ok = build__compile(b, cflags, pool, dirty);
+    for (size_t i = 0; i < b->sources.count; ++i)
+      if (!dirty || dirty[i])
+        build__watch_inputs(&w, b, i);
+    if (ok && b->run)
+      build__watch_start(b, pool);
+    if (ok && dirty)
+      nob_log(NOB_INFO, "ready %.2fs after the change",
+              (double)(nob_nanos_since_unspecified_epoch() - changed_ns) /
+                  NOB_NANOS_PER_SEC);
+    build_trace_write(pool->trace, trace_path);
+    pool->trace->events.count = trace_meta;
+    nob_temp_rewind(mark);
+
+    nob_log(NOB_INFO, "watching %zu directories for changes", w.dirs.count);
+    memset(w.dirty, 0, b->sources.count * sizeof *w.dirty);
+    int status = build__watch_wait(&w, b, &changed_ns);
+    if (status < 0)
+      break;
+    if (status > 0) {
+      nob_log(NOB_INFO, "build script or sources changed; restarting nob");
+      build__watch_stop(pool);
+      execv(b->argv[0], b->argv);
+      nob_log(NOB_ERROR, "could not restart %s: %s", b->argv[0],
+              strerror(errno));
+      break;
+    }
+    dirty = w.dirty;
+  }
+
+  build__watch_stop(pool);
+  for (size_t i = 0; i < b->sources.count; ++i) {
+    for (size_t j = 0; j < w.inputs[i].count; ++j)
+      free((char *)w.inputs[i].items[j]);
+    nob_da_free(w.inputs[i]);
+  }
+  for (size_t i = 0; i < w.dirs.count; ++i)
+    free(w.dirs.items[i].dir);
+  for (size_t i = 0; i < w.self.count; ++i)
+    free((char *)w.self.items[i]);
+  for (size_t i = 0; i < w.source_dirs.count; ++i)
+    free((char *)w.source_dirs.items[i]);
+  nob_da_free(w.dirs);
+  nob_da_free(w.self);
+  nob_da_free(w.source_dirs);
+  free(w.inputs);
+  free(w.dirty);
+  close(w.fd);
+  return false;
+}
+#else
+static bool build__watch(Build *b, Nob_Cmd cflags, Build_Pool *pool) {
+  NOB_UNUSED(b);
+  NOB_UNUSED(cflags);
+  NOB_UNUSED(pool);
+  nob_log(NOB_ERROR, "watch needs inotify, which is Linux only");
+  return false;
+}
+#endif
+
+BUILDDEF bool build_run(Build *b) {
+  build__defaults(b);
+  // The top-level driver sets NOB_JOBS to this project's share of the
+  // machine, so concurrent projects do not each start nproc compilers.
+  const char *env_jobs = getenv("NOB_JOBS");
+  size_t jobs = b->jobs                          ? b->jobs
+                : env_jobs && atoi(env_jobs) > 0 ? (size_t)atoi(env_jobs)
+                                                 : (size_t)nob_nprocs();
+
+  Build_Trace trace = {0};
+  build_trace_begin(&trace, build_output_path(b), jobs);
+  Build_Pool pool;
+  build__pool_init(&pool, jobs, &trace);
+
+  Nob_Cmd cflags = {0};
+  switch (b->profile) {
+  case BUILD_DEBUG:
+    nob_cmd_append(&cflags, "-O0", "-g");
+    break;
+  case BUILD_NATIVE:
+    nob_cmd_append(&cflags, "-O3", "-march=native", "-flto=auto");
+    break;
+  default:
+    nob_cmd_append(&cflags, "-O2", "-flto=auto");
+    break;
+  }
+  // Project flags come last so a project can still override the profile.
+  nob_da_append_many(&cflags, b->cflags.items, b->cflags.count);
+
+  Nob_File_Paths sources = b->sources;
+  if (b->unity) {
+    const char *unity =
+        build__mkdirs(b->build_dir) ? build__unity_source(b) : NULL;
+    if (!unity) {
+      nob_cmd_free(cflags);
+      build__pool_free(&pool);
+      nob_sb_free(trace.events);
+      return false;
+    }
+    b->sources = (Nob_File_Paths){0};
+    nob_da_append(&b->sources, unity);
+  }
+  const char *pch_dir = NULL;
+  if (b->pch && b->use_pch &&
+      build__mkdirs(nob_temp_sprintf("%s/obj", b->build_dir)))
+    pch_dir = build__pch(b, cflags, &pool);
+  if (pch_dir) {
+    Nob_Cmd with_pch = {0};
+    nob_cmd_append(&with_pch, "-I", pch_dir);
+    nob_da_append_many(&with_pch, cflags.items, cflags.count);
+    nob_cmd_free(cflags);
+    cflags = with_pch;
+  }
+
+  bool ok;
+  if (b->watch && b->profile == BUILD_PGO) {
+    nob_log(NOB_ERROR, "watch does not support the pgo profile");
+    nob_cmd_free(cflags);
+    ok = false;
+  } else if (b->watch) {
+    ok = build__watch(b, cflags, &pool);
+    nob_cmd_free(cflags);
+  } else if (b->profile == BUILD_PGO && b->train.count > 0) {
+    ok = build__pgo(b, cflags, &pool); // frees cflags
+  } else {
+    if (b->profile == BUILD_PGO)
+      nob_log(NOB_WARNING, "%s has no training run; building without PGO",
+              b->output);
+    ok = build__compile(b, cflags, &pool, NULL);
+    nob_cmd_free(cflags);
+  }
+
+  if (b->unity) {
+    nob_da_free(b->sources);
+    b->sources = sources;
+  }
+  build_trace_write(&trace, nob_temp_sprintf("%s/trace.json", b->build_dir));
+  nob_sb_free(trace.events);
+  build__pool_free(&pool);
+  return ok;
+}
+
+#endif
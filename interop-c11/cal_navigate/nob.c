@@ -1,29 +1,19 @@
 #define NOB_IMPLEMENTATION
 #include "nob.h"
+#include "../_lib/nob_build.h"
 
 int main(int argc, char **argv) {
-    NOB_GO_REBUILD_URSELF(argc, argv);
+    NOB_GO_REBUILD_URSELF_PLUS(argc, argv, "../_lib/nob_build.h");
 
-    // 1️⃣ Ensure "build" directory exists
-    if (!nob_mkdir_if_not_exists("build")) {
-        nob_log(NOB_ERROR, "Failed to create build directory");
-        return 1;
-    }
+    Build b = {.output = "main"};
+    if (!build_parse_args(&b, argc, argv)) return 1;
+    nob_cmd_append(&b.cflags, "-Wall", "-Wextra", "-std=c11", "-Iinclude");
+    nob_da_append(&b.sources, "src/main.c");
+    nob_da_append(&b.sources, "src/other.c");
 
-    // 2️⃣ Prepare compile command
-    Nob_Cmd cmd = {0};
-    nob_cmd_append(&cmd,
-        "cc",
-        "-Wall", "-Wextra", "-std=c11",
-        "-Iinclude",
-        "src/main.c", "src/other.c",
-        "-o", "build/main"
-    );
+    // Compiles only the TUs whose sources or headers changed, then links
+    if (!build_run(&b)) return 1;
 
-    // 3️⃣ Run the command
-    if (!nob_cmd_run_sync(cmd)) return 1;
-
-    nob_log(NOB_INFO, "Build complete: build/main");
+    nob_log(NOB_INFO, "Build complete: %s", build_output_path(&b));
     return 0;
 }
-
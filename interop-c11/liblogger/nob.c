@@ -0,0 +1,22 @@
+#define NOB_IMPLEMENTATION
+#include "nob.h"
+#include "../_lib/nob_build.h"
+
+// Builds _lib/logger.c as a shared library for the Dart binding in
+// liblogger.dart at the repository root. That loads build/liblogger.so, a link
+// to the library of the profile built last.
+int main(int argc, char **argv) {
+  NOB_GO_REBUILD_URSELF_PLUS(argc, argv, "../_lib/nob_build.h");
+
+  Build b = {.output = "liblogger.so"};
+  if (!build_parse_args(&b, argc, argv))
+    return 1;
+  nob_cmd_append(&b.cflags, "-Wall", "-Wextra", "-std=c11");
+  nob_cmd_append(&b.cflags, "-fPIC", "-I../_lib", "-pthread");
+  nob_cmd_append(&b.ldflags, "-shared");
+  nob_da_append(&b.sources, "../_lib/logger.c");
+  if (!build_run(&b) || !build_link_output(&b, "build/liblogger.so"))
+    return 1;
+  nob_log(NOB_INFO, "Build complete: %s", "build/liblogger.so");
+  return 0;
+}
@@ -0,0 +1,22 @@
+#define NOB_IMPLEMENTATION
+#include "nob.h"
+#include "../_lib/nob_build.h"
+
+int main(int argc, char **argv) {
+  NOB_GO_REBUILD_URSELF_PLUS(argc, argv, "../_lib/nob_build.h");
+
+  Build b = {.output = "bench"};
+  if (!build_parse_args(&b, argc, argv))
+    return 1;
+  nob_cmd_append(&b.cflags, "-Wall", "-Wextra", "-std=c11");
+  nob_cmd_append(&b.cflags, "-I../_lib");
+  nob_cmd_append(&b.cflags, "-pthread");
+  nob_da_append(&b.sources, "src/main.c");
+  nob_da_append(&b.sources, "../_lib/logger.c");
+  // pgo: a short sweep over every target
+  nob_cmd_append(&b.train, "--threads", "2", "--messages", "20000");
+  if (!build_run(&b))
+    return 1;
+  nob_log(NOB_INFO, "Build complete: %s", build_output_path(&b));
+  return 0;
+}
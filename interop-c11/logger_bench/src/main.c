@@ -0,0 +1,285 @@
+// Logger benchmark: throughput and per-call latency for each logger target,
+// swept over producer threads and message sizes. Prints JSON.
+//
+//   ./nob && ./build/release/bench --threads 8 --sizes 16,256,1024
+#define _GNU_SOURCE
+#include "logger.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ===== Latency Histogram =====
+// Log-linear buckets: 16 sub-buckets per power of two (~6% resolution).
+#define HIST_SUB 16
+#define HIST_BUCKETS (64 * HIST_SUB)
+
+typedef struct {
+  uint64_t counts[HIST_BUCKETS];
+  uint64_t max;
+} Histogram;
+
+static size_t hist_index(uint64_t v) {
+  if (v < HIST_SUB)
+    return v;
+  int exp = 63 - __builtin_clzll(v);
+  size_t sub = (v >> (exp - 4)) & (HIST_SUB - 1);
+  return (size_t)(exp - 3) * HIST_SUB + sub;
+}
+
+// Upper bound of a bucket, so percentiles never under-report.
+static uint64_t hist_value(size_t index) {
+  if (index < HIST_SUB)
+    return index;
+  int exp = (int)(index / HIST_SUB) + 3;
+  uint64_t sub = index % HIST_SUB;
+  return ((HIST_SUB + sub + 1) << (exp - 4)) - 1;
+}
+
+static void hist_record(Histogram *h, uint64_t v) {
+  h->counts[hist_index(v)]++;
+  if (v > h->max)
+    h->max = v;
+}
+
+static void hist_merge(Histogram *into, const Histogram *from) {
+  for (size_t i = 0; i < HIST_BUCKETS; i++)
+    into->counts[i] += from->counts[i];
+  if (from->max > into->max)
+    into->max = from->max;
+}
+
+static uint64_t hist_percentile(const Histogram *h, double p) {
+  uint64_t total = 0;
+  for (size_t i = 0; i < HIST_BUCKETS; i++)
+    total += h->counts[i];
+  uint64_t rank = (uint64_t)(p * (double)total);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < HIST_BUCKETS; i++) {
+    seen += h->counts[i];
+    if (seen > rank)
+      return hist_value(i) < h->max ? hist_value(i) : h->max;
+  }
+  return h->max;
+}
+
+// ===== Targets =====
+typedef enum {
+  TARGET_CONSOLE, // to /dev/null
+  TARGET_FILE,
+  TARGET_MULTI, // console + file
+  TARGET_BINARY,
+  TARGET_FIELDS, // structured JSON to file
+  TARGET_COUNT
+} Target;
+
+static const char *TARGET_NAMES[] = {"console", "file", "multi", "binary",
+                                     "fields"};
+
+typedef struct {
+  Logger logger;
+  FILE *devnull;
+} BenchLogger;
+
+static BenchLogger bench_open(Target target) {
+  BenchLogger b = {0};
+  unlink("build/bench.log");
+  switch (target) {
+  case TARGET_CONSOLE:
+    b.devnull = fopen("/dev/null", "w");
+    b.logger = make_console_logger(b.devnull);
+    break;
+  case TARGET_FILE:
+  case TARGET_FIELDS:
+    b.logger = make_file_logger("build/bench.log");
+    break;
+  case TARGET_MULTI: {
+    b.devnull = fopen("/dev/null", "w");
+    Logger targets[] = {make_console_logger(b.devnull),
+                        make_file_logger("build/bench.log")};
+    b.logger = make_multi_logger(targets, 2);
+    break;
+  }
+  case TARGET_BINARY:
+    b.logger = make_binary_logger("build/bench.bin", 1 << 20);
+    break;
+  default:
+    break;
+  }
+  return b;
+}
+
+static void bench_close(BenchLogger *b) {
+  b->logger.close(&b->logger);
+  if (b->devnull)
+    fclose(b->devnull);
+}
+
+// ===== Runner =====
+typedef struct {
+  Logger *logger;
+  Target target;
+  const char *payload;
+  size_t messages;
+  pthread_barrier_t *start;
+  Histogram hist;
+} Producer;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void *producer_run(void *arg) {
+  Producer *p = arg;
+  pthread_barrier_wait(p->start);
+  for (size_t i = 0; i < p->messages; i++) {
+    uint64_t t0 = now_ns();
+    if (p->target == TARGET_FIELDS)
+      LOG_FIELDS(p->logger, LOG_INFO, "bench", LOG_INT("seq", (int64_t)i),
+                 LOG_STR("payload", p->payload));
+    else
+      log_message(p->logger, LOG_INFO, "bench seq=%zu payload=%s", i,
+                  p->payload);
+    hist_record(&p->hist, now_ns() - t0);
+  }
+  return NULL;
+}
+
+typedef struct {
+  double seconds; // first call to last call, all producers
+  double close_seconds;
+  Histogram hist;
+} RunResult;
+
+static RunResult bench_run(Target target, size_t threads, size_t messages,
+                           const char *payload) {
+  BenchLogger b = bench_open(target);
+  pthread_barrier_t start;
+  pthread_barrier_init(&start, NULL, (unsigned)threads + 1);
+  Producer *producers = calloc(threads, sizeof(Producer));
+  pthread_t *tids = calloc(threads, sizeof(pthread_t));
+  for (size_t i = 0; i < threads; i++) {
+    producers[i] = (Producer){.logger = &b.logger,
+                              .target = target,
+                              .payload = payload,
+                              .messages = messages,
+                              .start = &start};
+    pthread_create(&tids[i], NULL, producer_run, &producers[i]);
+  }
+
+  pthread_barrier_wait(&start);
+  uint64_t t0 = now_ns();
+  for (size_t i = 0; i < threads; i++)
+    pthread_join(tids[i], NULL);
+  uint64_t t1 = now_ns();
+  bench_close(&b);
+  uint64_t t2 = now_ns();
+
+  RunResult r = {(t1 - t0) / 1e9, (t2 - t1) / 1e9, {{0}, 0}};
+  for (size_t i = 0; i < threads; i++)
+    hist_merge(&r.hist, &producers[i].hist);
+  pthread_barrier_destroy(&start);
+  free(producers);
+  free(tids);
+  return r;
+}
+
+// ===== Main =====
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [--threads N] [--messages M] [--sizes a,b,...]\n"
+          "          [--targets console,file,multi,binary,fields] [-o out]\n"
+          "Sweeps 1, 2, 4 .. N producer threads; M messages per thread.\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  size_t max_threads = 4;
+  size_t messages = 200000;
+  const char *sizes_arg = "16,256,1024";
+  const char *targets_arg = "console,file,multi,binary,fields";
+  const char *out_path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    const char *v = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!v) {
+      usage(argv[0]);
+      return 1;
+    }
+    if (!strcmp(a, "--threads"))
+      max_threads = strtoul(v, NULL, 10);
+    else if (!strcmp(a, "--messages"))
+      messages = strtoul(v, NULL, 10);
+    else if (!strcmp(a, "--sizes"))
+      sizes_arg = v;
+    else if (!strcmp(a, "--targets"))
+      targets_arg = v;
+    else if (!strcmp(a, "-o"))
+      out_path = v;
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+    i++;
+  }
+  if (max_threads == 0)
+    max_threads = 1;
+
+  FILE *out = out_path ? fopen(out_path, "w") : stdout;
+  if (!out) {
+    perror(out_path);
+    return 1;
+  }
+  log_set_level(LOG_DEBUG);
+  log_set_time_format(LOG_TIME_HMS, LOG_TIME_USEC);
+
+  fprintf(out, "{\n  \"messages_per_thread\": %zu,\n  \"results\": [", messages);
+  bool first = true;
+  for (int t = 0; t < TARGET_COUNT; t++) {
+    if (!strstr(targets_arg, TARGET_NAMES[t]))
+      continue;
+    for (const char *s = sizes_arg; *s;) {
+      char *end;
+      size_t size = strtoul(s, &end, 10);
+      s = *end ? end + 1 : end;
+      char *payload = malloc(size + 1);
+      memset(payload, 'x', size);
+      payload[size] = '\0';
+
+      for (size_t threads = 1; threads <= max_threads;
+           threads = threads * 2 <= max_threads || threads == max_threads
+                         ? threads * 2
+                         : max_threads) {
+        RunResult r = bench_run((Target)t, threads, messages, payload);
+        double total = (double)threads * (double)messages;
+        fprintf(out,
+                "%s\n    {\"target\": \"%s\", \"threads\": %zu, "
+                "\"message_bytes\": %zu, \"seconds\": %.6f, "
+                "\"close_seconds\": %.6f, \"msgs_per_sec\": %.0f, "
+                "\"latency_ns\": {\"p50\": %llu, \"p99\": %llu, "
+                "\"p999\": %llu, \"max\": %llu}}",
+                first ? "" : ",", TARGET_NAMES[t], threads, size, r.seconds,
+                r.close_seconds, total / r.seconds,
+                (unsigned long long)hist_percentile(&r.hist, 0.50),
+                (unsigned long long)hist_percentile(&r.hist, 0.99),
+                (unsigned long long)hist_percentile(&r.hist, 0.999),
+                (unsigned long long)r.hist.max);
+        fflush(out);
+        first = false;
+        fprintf(stderr, "%s threads=%zu size=%zu: %.0f msgs/sec\n",
+                TARGET_NAMES[t], threads, size, total / r.seconds);
+      }
+      free(payload);
+    }
+  }
+  fprintf(out, "\n  ]\n}\n");
+  if (out != stdout)
+    fclose(out);
+  return 0;
+}
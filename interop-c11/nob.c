@@ -0,0 +1,270 @@
+#define NOB_IMPLEMENTATION
+#include "nob.h"
+#include "_lib/nob_build.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+// Builds every subproject (each directory with a nob.c) concurrently.
+//
+//   cc -o nob nob.c && ./nob [-j N] [-p profile] [--unity] [--pch]
+//                            [project...]
+//
+// Each project's own nob is bootstrapped if needed and run inside the
+// project directory with the profile (release by default) and options; see
+// _lib/nob_build.h. Output goes to build/logs/<project>.log and is shown
+// for failed projects only, so parallel builds never interleave.
+//
+// Compiles are budgeted across projects: each one gets NOB_JOBS, a share of
+// the nob_nprocs() cores not held by the projects already running, so a
+// full build runs about nproc compilers rather than N projects times nproc.
+// The last projects to start get the cores the finished ones gave back.
+//
+// build/trace.json shows one lane per job slot with the projects that ran
+// in it, followed by each project's own trace (its compiles, per TU), all
+// on one timeline. Open it in chrome://tracing or ui.perfetto.dev.
+
+// Passed to every project's nob; together they name its build directory.
+static const char *profile = "release";
+static bool unity, pch;
+
+typedef struct {
+  const char *name;
+  const char *log_path;
+  Nob_Proc proc;
+  size_t slot;
+  size_t budget; // NOB_JOBS: parallel compiles within the project
+  uint64_t start_ns;
+  uint64_t end_ns;
+  bool ok;
+} Project;
+
+typedef struct {
+  Project *items;
+  size_t count;
+  size_t capacity;
+} Projects;
+
+static int compare_names(const void *a, const void *b) {
+  return strcmp(((const Project *)a)->name, ((const Project *)b)->name);
+}
+
+static bool discover(Projects *projects) {
+  Nob_File_Paths entries = {0};
+  if (!nob_read_entire_dir(".", &entries))
+    return false;
+  for (size_t i = 0; i < entries.count; ++i) {
+    const char *name = entries.items[i];
+    if (name[0] == '.' || name[0] == '_' || strcmp(name, "build") == 0)
+      continue;
+    if (nob_get_file_type(name) != NOB_FILE_DIRECTORY)
+      continue;
+    if (!nob_file_exists(nob_temp_sprintf("%s/nob.c", name)))
+      continue;
+    nob_da_append(projects, ((Project){.name = nob_temp_strdup(name)}));
+  }
+  qsort(projects->items, projects->count, sizeof(Project), compare_names);
+  return true;
+}
+
+// The mtime of the project's nob binary, recorded in build/logs/<p>.stamp
+// after each successful run. A binary this driver did not build (one
+// restored by a checkout, say) does not match and is rebuilt even when it
+// looks newer than nob.c.
+static const char *nob_stamp(const char *name) {
+  struct stat st;
+  if (stat(nob_temp_sprintf("%s/nob", name), &st) < 0)
+    return "";
+  return nob_temp_sprintf("%lld.%09ld", (long long)st.st_mtim.tv_sec,
+                          st.st_mtim.tv_nsec);
+}
+
+static bool stamp_matches(const char *name) {
+  Nob_String_Builder sb = {0};
+  const char *path = nob_temp_sprintf("build/logs/%s.stamp", name);
+  if (!nob_file_exists(path) || !nob_read_entire_file(path, &sb))
+    return false;
+  const char *stamp = nob_stamp(name);
+  bool match = sb.count == strlen(stamp) &&
+               memcmp(sb.items, stamp, sb.count) == 0;
+  nob_sb_free(sb);
+  return match;
+}
+
+static const char *trace_path(const char *name) {
+  return nob_temp_sprintf("%s/build/%s%s/trace.json", name, profile,
+                          unity ? "-unity" : "");
+}
+
+static bool start(Project *p, size_t index) {
+  p->log_path = nob_temp_sprintf("build/logs/%s.log", p->name);
+  Nob_Fd log = nob_fd_open_for_write(p->log_path);
+  if (log == NOB_INVALID_FD)
+    return false;
+
+  // Bootstrap the project's nob only when nob.c or nob.h changed.
+  const char *nob_bin = nob_temp_sprintf("%s/nob", p->name);
+  const char *inputs[] = {nob_temp_sprintf("%s/nob.c", p->name),
+                          nob_temp_sprintf("%s/nob.h", p->name)};
+  bool bootstrap = nob_needs_rebuild(nob_bin, inputs, NOB_ARRAY_LEN(inputs)) ||
+                   !stamp_matches(p->name);
+
+  Nob_Cmd cmd = {0};
+  nob_cmd_append(&cmd, "sh", "-c",
+                 bootstrap ? "cd \"$0\" && cc -o nob nob.c && ./nob \"$@\""
+                           : "cd \"$0\" && ./nob \"$@\"",
+                 p->name, profile);
+  if (unity)
+    nob_cmd_append(&cmd, "--unity");
+  if (pch)
+    nob_cmd_append(&cmd, "--pch");
+  // Puts the project's own trace in its own process row; a trace left from
+  // an earlier run must not be merged in if this one writes none.
+  remove(trace_path(p->name));
+  setenv("NOB_TRACE_PID", nob_temp_sprintf("%zu", index + 1), 1);
+  setenv("NOB_JOBS", nob_temp_sprintf("%zu", p->budget), 1);
+  p->start_ns = nob_nanos_since_unspecified_epoch();
+  p->proc = nob_cmd_run_async_redirect(
+      cmd, (Nob_Cmd_Redirect){.fdout = &log, .fderr = &log});
+  nob_fd_close(log);
+  nob_cmd_free(cmd);
+  return p->proc != NOB_INVALID_PROC;
+}
+
+// Waits for any running project and records its result.
+static Project *wait_any(Projects *projects) {
+  for (;;) {
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0)
+      return NULL;
+    for (size_t i = 0; i < projects->count; ++i) {
+      Project *p = &projects->items[i];
+      if (p->proc != pid)
+        continue;
+      p->end_ns = nob_nanos_since_unspecified_epoch();
+      p->ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+      p->proc = NOB_INVALID_PROC;
+      return p;
+    }
+  }
+}
+
+static void print_log(const char *path) {
+  Nob_String_Builder sb = {0};
+  if (nob_read_entire_file(path, &sb)) {
+    fwrite(sb.items, 1, sb.count, stderr);
+    nob_sb_free(sb);
+  }
+}
+
+int main(int argc, char **argv) {
+  NOB_GO_REBUILD_URSELF_PLUS(argc, argv, "_lib/nob_build.h");
+
+  const char *program = nob_shift(argv, argc);
+  size_t jobs = (size_t)nob_nprocs();
+  Projects wanted = {0};
+  while (argc > 0) {
+    const char *arg = nob_shift(argv, argc);
+    if (strcmp(arg, "-j") == 0 && argc > 0) {
+      jobs = (size_t)atoi(nob_shift(argv, argc));
+    } else if (strcmp(arg, "-p") == 0 && argc > 0) {
+      profile = nob_shift(argv, argc);
+    } else if (strcmp(arg, "--unity") == 0) {
+      unity = true;
+    } else if (strcmp(arg, "--pch") == 0) {
+      pch = true;
+    } else if (arg[0] == '-') {
+      nob_log(NOB_ERROR,
+              "usage: %s [-j N] [-p profile] [--unity] [--pch] [project...]",
+              program);
+      return 1;
+    } else {
+      nob_da_append(&wanted, ((Project){.name = arg}));
+    }
+  }
+  if (jobs == 0)
+    jobs = 1;
+
+  Projects projects = {0};
+  if (wanted.count > 0)
+    projects = wanted;
+  else if (!discover(&projects))
+    return 1;
+  if (!nob_mkdir_if_not_exists("build") ||
+      !nob_mkdir_if_not_exists("build/logs"))
+    return 1;
+
+  nob_log(NOB_INFO, "Building %zu projects, %zu at a time", projects.count,
+          jobs);
+  Build_Trace trace = {0};
+  build_trace_begin(&trace, "projects", jobs);
+  bool *busy = calloc(jobs, sizeof(bool));
+  uint64_t begin = nob_nanos_since_unspecified_epoch();
+  size_t cores = (size_t)nob_nprocs(), free_cores = cores;
+  size_t next = 0, running = 0, failed = 0;
+  while (next < projects.count || running > 0) {
+    while (running < jobs && next < projects.count) {
+      Project *p = &projects.items[next];
+      p->slot = 0;
+      while (busy[p->slot])
+        p->slot++;
+      // Split what is free evenly over the projects that can start now.
+      size_t starting = jobs - running;
+      if (starting > projects.count - next)
+        starting = projects.count - next;
+      p->budget = free_cores / starting ? free_cores / starting : 1;
+      if (start(p, next++)) {
+        busy[p->slot] = true;
+        free_cores -= p->budget < free_cores ? p->budget : free_cores;
+        running++;
+      } else {
+        p->ok = false;
+        failed++;
+        nob_log(NOB_ERROR, "%s: could not start", p->name);
+      }
+    }
+    if (running == 0)
+      continue;
+    Project *done = wait_any(&projects);
+    if (!done)
+      break;
+    running--;
+    busy[done->slot] = false;
+    free_cores += done->budget;
+    if (free_cores > cores)
+      free_cores = cores;
+    build_trace_event(&trace, "project", done->name, done->slot + 1,
+                      done->start_ns, done->end_ns, NULL, 0);
+    double secs = (double)(done->end_ns - done->start_ns) / NOB_NANOS_PER_SEC;
+    if (done->ok) {
+      const char *stamp = nob_stamp(done->name);
+      nob_write_entire_file(nob_temp_sprintf("build/logs/%s.stamp",
+                                             done->name),
+                            stamp, strlen(stamp));
+      nob_log(NOB_INFO, "%-20s ok      %6.2fs", done->name, secs);
+    } else {
+      failed++;
+      nob_log(NOB_ERROR, "%-20s FAILED  %6.2fs  (%s)", done->name, secs,
+              done->log_path);
+      print_log(done->log_path);
+    }
+  }
+
+  for (size_t i = 0; i < projects.count; ++i)
+    build_trace_include(&trace, trace_path(projects.items[i].name));
+  build_trace_write(&trace, "build/trace.json");
+  free(busy);
+
+  uint64_t serial = 0;
+  for (size_t i = 0; i < projects.count; ++i)
+    if (projects.items[i].end_ns)
+      serial += projects.items[i].end_ns - projects.items[i].start_ns;
+  double wall = (double)(nob_nanos_since_unspecified_epoch() - begin) /
+                NOB_NANOS_PER_SEC;
+  nob_log(NOB_INFO, "%zu/%zu projects built in %.2fs wall (%.2fs of work)",
+          projects.count - failed, projects.count, wall,
+          (double)serial / NOB_NANOS_PER_SEC);
+  return failed == 0 ? 0 : 1;
+}
@@ -1,29 +1,20 @@
 #define NOB_IMPLEMENTATION
 #include "nob.h"
+#include "../_lib/nob_build.h"
 
 int main(int argc, char **argv) {
-  // Ensure build directory exists
-  if (!nob_mkdir_if_not_exists("build")) {
-    nob_log(NOB_ERROR, "Failed to create build directory");
-    return 1;
-  }
-
-  Nob_Cmd cmd = {0};
-
-  // Output binary inside build/
-  const char *output = "build/random_number";
+  NOB_GO_REBUILD_URSELF_PLUS(argc, argv, "../_lib/nob_build.h");
 
-  nob_cmd_append(&cmd, "cc");
-  nob_cmd_append(&cmd, "-Wall", "-Wextra", "-std=c11");
-  nob_cmd_append(&cmd, "-Isrc");
-  // nob_cmd_append(&cmd, "src/main.c");
-  nob_cmd_append(&cmd, "src/random_number.c");
-  nob_cmd_append(&cmd, "-o", output);
-  nob_cmd_append(&cmd, "-lncurses");
-
-  if (!nob_cmd_run_sync(cmd))
+  Build b = {.output = "random_number"};
+  if (!build_parse_args(&b, argc, argv))
     return 1;
-
-  nob_log(NOB_INFO, "Build complete: %s", output);
+  nob_cmd_append(&b.cflags, "-Wall", "-Wextra", "-std=c11");
+  nob_cmd_append(&b.cflags, "-Isrc");
+  // nob_da_append(&b.sources, "src/main.c");
+  nob_da_append(&b.sources, "src/random_number.c");
+  nob_cmd_append(&b.ldflags, "-lncurses");
+  if (!build_run(&b))
+    return 1;
+  nob_log(NOB_INFO, "Build complete: %s", build_output_path(&b));
   return 0;
 }
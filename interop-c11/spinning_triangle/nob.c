@@ -1,67 +1,33 @@
 #define NOB_IMPLEMENTATION
 #include "nob.h"
-#include <stdio.h>
-#include <string.h>
-
-bool ends_with(const char *str, const char *suffix) {
-  if (!str || !suffix)
-    return false;
-  size_t len_str = strlen(str);
-  size_t len_suf = strlen(suffix);
-  if (len_suf > len_str)
-    return false;
-  return strcmp(str + len_str - len_suf, suffix) == 0;
-}
+#include "../_lib/nob_build.h"
 
 int main(int argc, char **argv) {
-  const char *build_dir = "build";
-  const char *src_dir = "src";
-  const char *exe_path = "build/game";
+  NOB_GO_REBUILD_URSELF_PLUS(argc, argv, "../_lib/nob_build.h");
 
   const char *raylib_include = "../_raylib-5.5_linux_amd64/include";
   const char *raylib_lib = "../_raylib-5.5_linux_amd64/lib";
 
   bool use_static = true; // toggle this flag for static/dynamic
 
-  nob_mkdir_if_not_exists(build_dir);
-
-  Nob_File_Paths sources = {0};
-  nob_read_entire_dir(src_dir, &sources);
-
-  Nob_Cmd cmd = {0};
-  nob_cmd_append(&cmd, "cc");
-
-  nob_cmd_append(&cmd, "-I");
-  nob_cmd_append(&cmd, raylib_include);
-
-  for (size_t i = 0; i < sources.count; ++i) {
-    if (ends_with(sources.items[i], ".c")) {
-      char full_path[512];
-      snprintf(full_path, sizeof(full_path), "%s/%s", src_dir,
-               sources.items[i]);
-      nob_cmd_append(&cmd, full_path);
-    }
-  }
-
-  nob_cmd_append(&cmd, "-o");
-  nob_cmd_append(&cmd, exe_path);
+  Build b = {.output = "game"};
+  if (!build_parse_args(&b, argc, argv))
+    return 1;
+  if (!build_add_dir_sources(&b, "src"))
+    return 1;
 
-  nob_cmd_append(&cmd, "-L");
-  nob_cmd_append(&cmd, raylib_lib);
+  nob_cmd_append(&b.cflags, "-I", raylib_include);
+  b.pch = nob_temp_sprintf("%s/raylib.h", raylib_include);
 
+  nob_cmd_append(&b.ldflags, "-L", raylib_lib);
   if (use_static) {
-    nob_cmd_append(&cmd, "-l:libraylib.a"); // static file in raylib/lib
+    nob_cmd_append(&b.ldflags, "-l:libraylib.a"); // static file in raylib/lib
   } else {
-    nob_cmd_append(&cmd, "-lraylib"); // dynamic .so/.dylib/.dll
+    nob_cmd_append(&b.ldflags, "-lraylib"); // dynamic .so/.dylib/.dll
   }
+  nob_cmd_append(&b.ldflags, "-lm", "-ldl", "-lpthread", "-lGL", "-lX11");
 
-  nob_cmd_append(&cmd, "-lm");
-  nob_cmd_append(&cmd, "-ldl");
-  nob_cmd_append(&cmd, "-lpthread");
-  nob_cmd_append(&cmd, "-lGL");
-  nob_cmd_append(&cmd, "-lX11");
-
-  if (!nob_cmd_run_sync(cmd))
+  if (!build_run(&b))
     return 1;
 
   return 0;
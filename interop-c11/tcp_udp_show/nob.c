@@ -1,19 +1,19 @@
 #define NOB_IMPLEMENTATION
 #include "nob.h"
+#include "../_lib/nob_build.h"
 
 int main(int argc, char **argv) {
-  if (!nob_mkdir_if_not_exists("build"))
-    return 1;
-  Nob_Cmd cmd = {0};
-  nob_cmd_append(&cmd, "cc");
-  nob_cmd_append(&cmd, "-Wall", "-Wextra", "-std=c11");
-  nob_cmd_append(&cmd, "-Isrc");
-  nob_cmd_append(&cmd, "src/main.c");
-  nob_cmd_append(&cmd, "-o", "build/app");
-  nob_cmd_append(&cmd, "-lncurses");
+  NOB_GO_REBUILD_URSELF_PLUS(argc, argv, "../_lib/nob_build.h");
 
-  if (!nob_cmd_run_sync(cmd))
+  Build b = {.output = "app"};
+  if (!build_parse_args(&b, argc, argv))
+    return 1;
+  nob_cmd_append(&b.cflags, "-Wall", "-Wextra", "-std=c11");
+  nob_cmd_append(&b.cflags, "-Isrc");
+  nob_da_append(&b.sources, "src/main.c");
+  nob_cmd_append(&b.ldflags, "-lncurses");
+  if (!build_run(&b))
     return 1;
-  nob_log(NOB_INFO, "Build complete: %s", "build/app");
+  nob_log(NOB_INFO, "Build complete: %s", build_output_path(&b));
   return 0;
 }
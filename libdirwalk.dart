@@ -0,0 +1,176 @@
+// libdirwalk.dart — Dart binding for interop-c11/_lib/dirwalk.c
+//
+// Build the library first: cd interop-c11/libdirwalk && cc -o nob nob.c && ./nob
+//
+// The walk runs on native worker threads (getdents64, statx only when size
+// or mtime is requested); Dart pulls finished batches of entries with one
+// FFI call per few hundred entries.
+import 'dart:convert';
+import 'dart:ffi' as ffi;
+import 'dart:io' show Platform, FileSystemException;
+
+ffi.DynamicLibrary _openLib() {
+  if (Platform.isLinux) {
+    return ffi.DynamicLibrary.open(
+        './interop-c11/libdirwalk/build/libdirwalk.so');
+  }
+  throw UnsupportedError('This platform is not supported.');
+}
+
+final ffi.DynamicLibrary _lib = _openLib();
+final ffi.DynamicLibrary _libc = ffi.DynamicLibrary.process();
+
+/// Mirrors `WalkEntry` in dirwalk.h.
+final class WalkEntry extends ffi.Struct {
+  external ffi.Pointer<ffi.Uint8> path;
+
+  @ffi.Uint32()
+  external int pathLength;
+
+  @ffi.Uint8()
+  external int type;
+
+  @ffi.Uint16()
+  external int depth;
+
+  @ffi.Int64()
+  external int size;
+
+  @ffi.Int64()
+  external int mtimeNs;
+}
+
+/// Mirrors `WalkBatch` in dirwalk.h.
+final class WalkBatch extends ffi.Struct {
+  @ffi.Size()
+  external int count;
+
+  external ffi.Pointer<WalkEntry> entries;
+}
+
+/// Same order as `WalkType` in dirwalk.h.
+enum EntryType { file, directory, symlink, other }
+
+class DirEntry {
+  final String path;
+  final EntryType type;
+  final int depth;
+
+  /// -1 unless the walk was started with `stat: true`.
+  final int size;
+
+  /// null unless the walk was started with `stat: true`.
+  final DateTime? modified;
+
+  DirEntry(this.path, this.type, this.depth, this.size, this.modified);
+}
+
+// C signatures
+typedef _COpen = ffi.Pointer<ffi.Void> Function(
+    ffi.Pointer<ffi.Uint8>, ffi.Uint32, ffi.Int32, ffi.Uint32);
+typedef _CNext = ffi.Pointer<WalkBatch> Function(ffi.Pointer<ffi.Void>);
+typedef _CClose = ffi.Int32 Function(ffi.Pointer<ffi.Void>);
+typedef _CMalloc = ffi.Pointer<ffi.Void> Function(ffi.Size);
+typedef _CFree = ffi.Void Function(ffi.Pointer<ffi.Void>);
+
+// Dart signatures
+typedef _DartOpen = ffi.Pointer<ffi.Void> Function(
+    ffi.Pointer<ffi.Uint8>, int, int, int);
+typedef _DartNext = ffi.Pointer<WalkBatch> Function(ffi.Pointer<ffi.Void>);
+typedef _DartClose = int Function(ffi.Pointer<ffi.Void>);
+typedef _DartMalloc = ffi.Pointer<ffi.Void> Function(int);
+typedef _DartFree = void Function(ffi.Pointer<ffi.Void>);
+
+// Lookups
+final _open = _lib.lookupFunction<_COpen, _DartOpen>('dirwalk_open');
+final _next = _lib.lookupFunction<_CNext, _DartNext>('dirwalk_next');
+final _close = _lib.lookupFunction<_CClose, _DartClose>('dirwalk_close');
+final _malloc = _libc.lookupFunction<_CMalloc, _DartMalloc>('malloc');
+final _free = _libc.lookupFunction<_CFree, _DartFree>('free');
+
+const _flagStat = 1;
+const _flagHidden = 2;
+
+/// A native directory walk, consumed batch by batch.
+///
+/// Entries arrive in no particular order (directories are read in
+/// parallel). Always [close] the walker, also after stopping early; it
+/// throws if the root could not be opened.
+class NativeDirWalker {
+  final String root;
+  ffi.Pointer<ffi.Void> _handle;
+
+  NativeDirWalker._(this.root, this._handle);
+
+  factory NativeDirWalker(String root,
+      {int threads = 0,
+      int maxDepth = -1,
+      bool stat = false,
+      bool hidden = true}) {
+    final bytes = utf8.encode(root);
+    final cRoot = _malloc(bytes.length + 1).cast<ffi.Uint8>();
+    cRoot.asTypedList(bytes.length + 1)
+      ..setAll(0, bytes)
+      ..[bytes.length] = 0;
+    final flags = (stat ? _flagStat : 0) | (hidden ? _flagHidden : 0);
+    final handle = _open(cRoot, threads, maxDepth, flags);
+    _free(cRoot.cast());
+    if (handle.address == 0) {
+      throw StateError('Failed to start directory walk');
+    }
+    return NativeDirWalker._(root, handle);
+  }
+
+  /// The next batch, or null once the walk is complete.
+  List<DirEntry>? nextBatch() {
+    if (_handle.address == 0) throw StateError('NativeDirWalker is closed');
+    final batch = _next(_handle);
+    if (batch.address == 0) return null;
+
+    final count = batch.ref.count;
+    final entries = batch.ref.entries;
+    return List.generate(count, (i) {
+      final e = entries[i];
+      final path = utf8.decode(e.path.asTypedList(e.pathLength),
+          allowMalformed: true);
+      final modified = e.mtimeNs < 0
+          ? null
+          : DateTime.fromMicrosecondsSinceEpoch(e.mtimeNs ~/ 1000);
+      return DirEntry(path, EntryType.values[e.type], e.depth, e.size, modified);
+    }, growable: false);
+  }
+
+  void close() {
+    if (_handle.address == 0) return;
+    final error = _close(_handle);
+    _handle = ffi.Pointer.fromAddress(0);
+    if (error != 0) {
+      throw FileSystemException('Cannot walk directory (errno $error)', root);
+    }
+  }
+}
+
+/// Calls [visit] with every entry under [root] until it returns false.
+///
+/// The walker is always closed, also when [visit] stops early or throws;
+/// an abandoned walk would leave its native threads blocked on a full
+/// queue. (A `sync*` iterable cannot promise that: nothing runs when the
+/// caller stops iterating.)
+void walkDirectory(String root, bool Function(DirEntry entry) visit,
+    {int threads = 0,
+    int maxDepth = -1,
+    bool stat = false,
+    bool hidden = true}) {
+  final walker = NativeDirWalker(root,
+      threads: threads, maxDepth: maxDepth, stat: stat, hidden: hidden);
+  try {
+    List<DirEntry>? batch;
+    while ((batch = walker.nextBatch()) != null) {
+      for (final entry in batch!) {
+        if (!visit(entry)) return;
+      }
+    }
+  } finally {
+    walker.close();
+  }
+}
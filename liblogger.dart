@@ -0,0 +1,189 @@
+// liblogger.dart — Dart binding for interop-c11/_lib/logger.c
+//
+// Build the library first: cd interop-c11/liblogger && cc -o nob nob.c && ./nob
+//
+// Records are staged in native memory and handed to C in batches through one
+// leaf FFI call (log_submit_batch), so Dart tools write the same files and
+// line format as the C services at a fraction of the per-line call cost.
+import 'dart:async';
+import 'dart:convert';
+import 'dart:ffi' as ffi;
+import 'dart:io' show Platform, FileSystemException;
+import 'dart:typed_data';
+
+ffi.DynamicLibrary _openLib() {
+  if (Platform.isLinux) {
+    return ffi.DynamicLibrary.open('./interop-c11/liblogger/build/liblogger.so');
+  }
+  throw UnsupportedError('This platform is not supported.');
+}
+
+final ffi.DynamicLibrary _lib = _openLib();
+final ffi.DynamicLibrary _libc = ffi.DynamicLibrary.process();
+
+/// Mirrors `LogRecord` in logger.h.
+final class LogRecord extends ffi.Struct {
+  @ffi.Int32()
+  external int level;
+
+  @ffi.Uint32()
+  external int length;
+
+  external ffi.Pointer<ffi.Uint8> message;
+}
+
+/// Same order as `LogLevel` in logger.h.
+enum LogLevel { debug, info, warn, error }
+
+// C signatures
+typedef _COpenFile = ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Uint8>);
+typedef _COpenConsole = ffi.Pointer<ffi.Void> Function();
+typedef _CClose = ffi.Void Function(ffi.Pointer<ffi.Void>);
+typedef _CSubmit = ffi.Void Function(
+    ffi.Pointer<ffi.Void>, ffi.Pointer<LogRecord>, ffi.Size);
+typedef _CSetLevel = ffi.Void Function(ffi.Int32);
+typedef _CMalloc = ffi.Pointer<ffi.Void> Function(ffi.Size);
+typedef _CFree = ffi.Void Function(ffi.Pointer<ffi.Void>);
+
+// Dart signatures
+typedef _DartOpenFile = ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Uint8>);
+typedef _DartOpenConsole = ffi.Pointer<ffi.Void> Function();
+typedef _DartClose = void Function(ffi.Pointer<ffi.Void>);
+typedef _DartSubmit = void Function(
+    ffi.Pointer<ffi.Void>, ffi.Pointer<LogRecord>, int);
+typedef _DartSetLevel = void Function(int);
+typedef _DartMalloc = ffi.Pointer<ffi.Void> Function(int);
+typedef _DartFree = void Function(ffi.Pointer<ffi.Void>);
+
+// Lookups
+final _openFile =
+    _lib.lookupFunction<_COpenFile, _DartOpenFile>('logger_open_file');
+final _openConsole =
+    _lib.lookupFunction<_COpenConsole, _DartOpenConsole>('logger_open_console');
+final _close = _lib.lookupFunction<_CClose, _DartClose>('logger_close');
+final _submitBatch = _lib.lookupFunction<_CSubmit, _DartSubmit>(
+    'log_submit_batch',
+    isLeaf: true);
+final _setLevel =
+    _lib.lookupFunction<_CSetLevel, _DartSetLevel>('log_set_level');
+final _malloc = _libc.lookupFunction<_CMalloc, _DartMalloc>('malloc');
+final _free = _libc.lookupFunction<_CFree, _DartFree>('free');
+
+/// Sets the process-wide minimum level (shared with C code in the process).
+void setNativeLogLevel(LogLevel level) => _setLevel(level.index);
+
+/// A C logger fed in batches.
+///
+/// Lines are submitted when [batchSize] records or [arenaBytes] of text are
+/// pending, when [flushInterval] elapses, and on [flush]/[close]. Loggers
+/// are safe to share across isolates: pass [address] to another isolate and
+/// wrap it with [NativeLogger.attach]; each isolate keeps its own staging
+/// buffers and the C side serializes the writes.
+class NativeLogger {
+  final ffi.Pointer<ffi.Void> _handle;
+  final bool _owned;
+  final int batchSize;
+  final int arenaBytes;
+  final Duration flushInterval;
+
+  late final ffi.Pointer<LogRecord> _records;
+  late final ffi.Pointer<ffi.Uint8> _arena;
+  late final Uint8List _arenaView;
+  int _count = 0;
+  int _used = 0;
+  Timer? _timer;
+  bool _closed = false;
+
+  NativeLogger._(this._handle, this._owned, this.batchSize, this.arenaBytes,
+      this.flushInterval) {
+    if (_handle.address == 0) {
+      throw StateError('Failed to open native logger');
+    }
+    _records = _malloc(ffi.sizeOf<LogRecord>() * batchSize).cast();
+    _arena = _malloc(arenaBytes).cast();
+    _arenaView = _arena.asTypedList(arenaBytes);
+  }
+
+  /// Appends to [path] with the C file logger's default batching policy.
+  factory NativeLogger.file(String path,
+      {int batchSize = 256,
+      int arenaBytes = 64 * 1024,
+      Duration flushInterval = const Duration(milliseconds: 200)}) {
+    final bytes = utf8.encode(path);
+    final cPath = _malloc(bytes.length + 1).cast<ffi.Uint8>();
+    cPath.asTypedList(bytes.length + 1)
+      ..setAll(0, bytes)
+      ..[bytes.length] = 0;
+    final handle = _openFile(cPath);
+    _free(cPath.cast());
+    if (handle.address == 0) {
+      throw FileSystemException('Cannot open log file', path);
+    }
+    return NativeLogger._(handle, true, batchSize, arenaBytes, flushInterval);
+  }
+
+  /// Writes to the process's stdout.
+  factory NativeLogger.console(
+          {int batchSize = 256,
+          int arenaBytes = 64 * 1024,
+          Duration flushInterval = const Duration(milliseconds: 200)}) =>
+      NativeLogger._(
+          _openConsole(), true, batchSize, arenaBytes, flushInterval);
+
+  /// Wraps a logger opened elsewhere (e.g. in another isolate). [close] only
+  /// flushes and releases this wrapper's buffers.
+  factory NativeLogger.attach(int address,
+          {int batchSize = 256,
+          int arenaBytes = 64 * 1024,
+          Duration flushInterval = const Duration(milliseconds: 200)}) =>
+      NativeLogger._(ffi.Pointer.fromAddress(address), false, batchSize,
+          arenaBytes, flushInterval);
+
+  /// Native handle address, sendable to other isolates.
+  int get address => _handle.address;
+
+  void debug(String message) => log(LogLevel.debug, message);
+  void info(String message) => log(LogLevel.info, message);
+  void warn(String message) => log(LogLevel.warn, message);
+  void error(String message) => log(LogLevel.error, message);
+
+  void log(LogLevel level, String message) {
+    if (_closed) throw StateError('NativeLogger is closed');
+    var bytes = utf8.encode(message);
+    if (bytes.length > arenaBytes) bytes = bytes.sublist(0, arenaBytes);
+    if (_count == batchSize || _used + bytes.length > arenaBytes) flush();
+
+    _arenaView.setAll(_used, bytes);
+    final record = _records[_count];
+    record.level = level.index;
+    record.length = bytes.length;
+    record.message = ffi.Pointer.fromAddress(_arena.address + _used);
+    _used += bytes.length;
+    _count++;
+
+    if (level == LogLevel.error) {
+      flush();
+    } else {
+      _timer ??= Timer(flushInterval, flush);
+    }
+  }
+
+  /// Submits everything staged so far in one FFI call.
+  void flush() {
+    _timer?.cancel();
+    _timer = null;
+    if (_count == 0) return;
+    _submitBatch(_handle, _records, _count);
+    _count = 0;
+    _used = 0;
+  }
+
+  void close() {
+    if (_closed) return;
+    flush();
+    _closed = true;
+    _free(_records.cast());
+    _free(_arena.cast());
+    if (_owned) _close(_handle);
+  }
+}
@@ -0,0 +1,26 @@
+import 'dart:isolate';
+
+import 'liblogger.dart';
+
+void _worker(int address) {
+  final worker = NativeLogger.attach(address);
+  for (var i = 0; i < 1000; i++) {
+    worker.info('worker isolate message $i');
+  }
+  worker.close();
+}
+
+// Two isolates logging through one C file logger.
+Future<void> main() async {
+  final logger = NativeLogger.file('dart_app.log');
+  setNativeLogLevel(LogLevel.info);
+
+  final address = logger.address;
+  await Isolate.run(() => _worker(address));
+
+  logger.info('main isolate started');
+  logger.debug('filtered out by the C level check');
+  logger.error('errors are submitted immediately');
+  logger.close();
+  print('Wrote dart_app.log');
+}